@@ -39,6 +39,8 @@ if (WITH_ASM AND NOT XMRIG_ARM AND CMAKE_SIZEOF_VOID_P EQUAL 8)
     set(XMRIG_ASM_SOURCES
         src/crypto/common/Assembly.h
         src/crypto/common/Assembly.cpp
+        src/crypto/cn/r/CnRCache.cpp
+        src/crypto/cn/r/CnRCache.h
         src/crypto/cn/r/CryptonightR_gen.cpp
         )
     set_property(TARGET ${XMRIG_ASM_LIBRARY} PROPERTY LINKER_LANGUAGE C)
@@ -99,6 +99,14 @@ if (WITH_RANDOMX)
         endif()
     endif()
 
+    if (WITH_SSSE3)
+        list(APPEND SOURCES_CRYPTO src/crypto/randomx/aes_hash_vperm.cpp)
+
+        if (CMAKE_CXX_COMPILER_ID MATCHES GNU OR CMAKE_CXX_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/randomx/aes_hash_vperm.cpp PROPERTIES COMPILE_FLAGS -mssse3)
+        endif()
+    endif()
+
     if (CMAKE_CXX_COMPILER_ID MATCHES Clang)
         set_source_files_properties(src/crypto/randomx/jit_compiler_x86.cpp PROPERTIES COMPILE_FLAGS -Wno-unused-const-variable)
     endif()
@@ -113,6 +121,16 @@ if (WITH_RANDOMX)
             )
     endif()
 
+    if (WITH_HTTP)
+        list(APPEND HEADERS_CRYPTO
+             src/crypto/rx/RxVerifier.h
+            )
+
+        list(APPEND SOURCES_CRYPTO
+             src/crypto/rx/RxVerifier.cpp
+            )
+    endif()
+
     if (WITH_MSR AND NOT XMRIG_ARM AND CMAKE_SIZEOF_VOID_P EQUAL 8 AND (XMRIG_OS_WIN OR XMRIG_OS_LINUX))
         add_definitions(/DXMRIG_FEATURE_MSR)
         add_definitions(/DXMRIG_FIX_RYZEN)
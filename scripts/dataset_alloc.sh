@@ -0,0 +1,58 @@
+#!/bin/bash -e
+
+# Measures the RandomX dataset allocation time (huge pages reservation and prefault), as reported by the
+# "dataset_alloc" startup phase, with one prefault thread and with one thread per CPU, for 2 MB pages and,
+# if the kernel has 1 GB pages reserved (see enable_1gb_pages.sh), for 1 GB pages.
+#
+# Usage: dataset_alloc.sh <path to xmrig> [runs]
+
+XMRIG=${1:?usage: $0 <path to xmrig> [runs]}
+RUNS=${2:-3}
+LOG=$(mktemp)
+CONFIG=$(mktemp)
+
+trap 'rm -f "$LOG" "$CONFIG"' EXIT
+
+# A known algo-perf value skips the algorithm performance calibration, it would run before the benchmark.
+echo '{ "autosave": false, "algo-perf": { "rx/0": 1.0 } }' > "$CONFIG"
+
+measure()
+{
+    rm -f "$LOG"
+    "$XMRIG" -c "$CONFIG" --no-color --bench=1M --randomx-init="$1" --log-file="$LOG" "${@:2}" > /dev/null 2>&1 &
+    local pid=$!
+
+    while kill -0 $pid 2> /dev/null && ! grep -q "dataset_alloc" "$LOG" 2> /dev/null; do
+        sleep 0.5
+    done
+
+    kill $pid 2> /dev/null || true
+    wait $pid 2> /dev/null || true
+
+    grep -o "dataset_alloc:[0-9]*" "$LOG" | head -n 1 | cut -d: -f2
+}
+
+run()
+{
+    local name=$1
+    shift
+
+    for threads in $(printf "%s\n" 1 "$(nproc)" | sort -un); do
+        local results=""
+
+        for i in $(seq "$RUNS"); do
+            results="$results $(measure $threads "$@")"
+        done
+
+        echo "$name, $threads prefault threads:$results ms"
+    done
+}
+
+grep -i "hugepages_\(total\|free\)" /proc/meminfo
+run "2 MB pages"
+
+if grep -qs "[1-9]" /sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages; then
+    run "1 GB pages" --randomx-1gb-pages
+else
+    echo "1 GB pages: not reserved, skipped"
+fi
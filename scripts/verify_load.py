@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Synthetic load generator for the RandomX batch verification endpoint (POST /2/verify).
+
+Sends random blobs from several concurrent clients for a fixed time and prints throughput and latency.
+The miner must run a RandomX job with "randomx": { "verify-threads": N } and the HTTP API enabled.
+
+    ./verify_load.py --url http://127.0.0.1:44444 --batch 64 --clients 4 --duration 30
+"""
+
+import argparse
+import json
+import os
+import threading
+import time
+import urllib.error
+import urllib.request
+
+
+def post(url, token, payload):
+    req = urllib.request.Request(url + '/2/verify', data=json.dumps(payload).encode(), method='POST')
+    req.add_header('Content-Type', 'application/json')
+    if token:
+        req.add_header('Authorization', 'Bearer ' + token)
+
+    with urllib.request.urlopen(req, timeout=300) as res:
+        return json.loads(res.read())
+
+
+def client(args, stats, lock, deadline):
+    while time.monotonic() < deadline:
+        blobs = [os.urandom(args.size).hex() for _ in range(args.batch)]
+        payload = {'blobs': blobs}
+        if args.seed:
+            payload['seed_hash'] = args.seed
+
+        start = time.monotonic()
+        try:
+            reply = post(args.url, args.token, payload)
+        except urllib.error.HTTPError as e:
+            with lock:
+                stats['errors'][e.code] = stats['errors'].get(e.code, 0) + 1
+            time.sleep(0.1)
+            continue
+
+        latency = time.monotonic() - start
+
+        if args.check:
+            again = post(args.url, args.token, dict(payload, results=reply['hashes']))
+            if not all(again['valid']):
+                with lock:
+                    stats['mismatch'] += 1
+
+        with lock:
+            stats['hashes'] += reply['count']
+            stats['light'] += reply['light']
+            stats['latency'].append(latency)
+            stats['queue'].append(reply['queue_ms'] / 1000.0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='RandomX batch verification load generator')
+    parser.add_argument('--url', default='http://127.0.0.1:44444', help='miner HTTP API base URL')
+    parser.add_argument('--token', default=None, help='HTTP API access token')
+    parser.add_argument('--seed', default=None, help='seed hash, default is the seed of the current job')
+    parser.add_argument('--batch', type=int, default=64, help='blobs per request (1-4096)')
+    parser.add_argument('--size', type=int, default=76, help='blob size in bytes')
+    parser.add_argument('--clients', type=int, default=4, help='concurrent clients')
+    parser.add_argument('--duration', type=float, default=30.0, help='test duration in seconds')
+    parser.add_argument('--check', action='store_true', help='submit every batch again with the returned hashes and check they are valid')
+    args = parser.parse_args()
+
+    stats = {'hashes': 0, 'light': 0, 'mismatch': 0, 'latency': [], 'queue': [], 'errors': {}}
+    lock = threading.Lock()
+    start = time.monotonic()
+    deadline = start + args.duration
+
+    threads = [threading.Thread(target=client, args=(args, stats, lock, deadline)) for _ in range(args.clients)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    elapsed = time.monotonic() - start
+    latency = sorted(stats['latency'])
+
+    def pct(values, p):
+        return values[min(len(values) - 1, int(len(values) * p))] * 1000.0 if values else 0.0
+
+    print('batches:   %d x %d blobs, %d clients, %.1f s' % (len(latency), args.batch, args.clients, elapsed))
+    print('hashes:    %d (%d light), %.1f H/s' % (stats['hashes'], stats['light'], stats['hashes'] / elapsed))
+    print('latency:   p50 %.1f ms, p90 %.1f ms, p99 %.1f ms' % (pct(latency, 0.5), pct(latency, 0.9), pct(latency, 0.99)))
+    print('queue:     p50 %.1f ms, p99 %.1f ms' % (pct(sorted(stats['queue']), 0.5), pct(sorted(stats['queue']), 0.99)))
+
+    if stats['errors']:
+        print('errors:    %s' % ', '.join('%d x %d' % (n, code) for code, n in sorted(stats['errors'].items())))
+    if args.check:
+        print('mismatch:  %d' % stats['mismatch'])
+
+
+if __name__ == '__main__':
+    main()
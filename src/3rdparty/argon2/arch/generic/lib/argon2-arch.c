@@ -14,6 +14,16 @@ void fill_segment_default(const argon2_instance_t *instance,
     fill_segment_64(instance, position);
 }
 
+void fill_segment_multi_default(const argon2_instance_t *const *instances,
+                                uint32_t count, argon2_position_t position)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; ++i) {
+        fill_segment_64(instances[i], position);
+    }
+}
+
 void argon2_get_impl_list(argon2_impl_list *list)
 {
     list->count = 0;
@@ -22,15 +22,25 @@ void fill_segment_default(const argon2_instance_t *instance,
     fill_segment_64(instance, position);
 }
 
+void fill_segment_multi_default(const argon2_instance_t *const *instances,
+                                uint32_t count, argon2_position_t position)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; ++i) {
+        fill_segment_64(instances[i], position);
+    }
+}
+
 void argon2_get_impl_list(argon2_impl_list *list)
 {
     static const argon2_impl IMPLS[] = {
-        { "x86_64",     NULL,                     fill_segment_default },
-        { "SSE2",       xmrig_ar2_check_sse2,     xmrig_ar2_fill_segment_sse2 },
-        { "SSSE3",      xmrig_ar2_check_ssse3,    xmrig_ar2_fill_segment_ssse3 },
-        { "XOP",        xmrig_ar2_check_xop,      xmrig_ar2_fill_segment_xop },
-        { "AVX2",       xmrig_ar2_check_avx2,     xmrig_ar2_fill_segment_avx2 },
-        { "AVX-512F",   xmrig_ar2_check_avx512f,  xmrig_ar2_fill_segment_avx512f },
+        { "x86_64",     NULL,                     fill_segment_default,           fill_segment_multi_default },
+        { "SSE2",       xmrig_ar2_check_sse2,     xmrig_ar2_fill_segment_sse2,    xmrig_ar2_fill_segment_multi_sse2 },
+        { "SSSE3",      xmrig_ar2_check_ssse3,    xmrig_ar2_fill_segment_ssse3,   xmrig_ar2_fill_segment_multi_ssse3 },
+        { "XOP",        xmrig_ar2_check_xop,      xmrig_ar2_fill_segment_xop,     xmrig_ar2_fill_segment_multi_xop },
+        { "AVX2",       xmrig_ar2_check_avx2,     xmrig_ar2_fill_segment_avx2,    xmrig_ar2_fill_segment_multi_avx2 },
+        { "AVX-512F",   xmrig_ar2_check_avx512f,  xmrig_ar2_fill_segment_avx512f, xmrig_ar2_fill_segment_multi_avx512f },
     };
 
     list->count = sizeof(IMPLS) / sizeof(IMPLS[0]);
@@ -308,12 +308,24 @@ void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_po
     }
 }
 
+#define ARGON2_MULTI_STATE __m512i
+#define ARGON2_MULTI_WORDS ARGON2_VECS_IN_BLOCK
+#define ARGON2_MULTI_NAME  fill_segment_multi_avx512f
+
+#include "argon2-template-multi.h"
+
+void xmrig_ar2_fill_segment_multi_avx512f(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi_avx512f(instances, count, position);
+}
+
 extern int cpu_flags_has_avx512f(void);
 int xmrig_ar2_check_avx512f(void) { return cpu_flags_has_avx512f(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx512f(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_multi_avx512f(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx512f(void) { return 0; }
 
 #endif
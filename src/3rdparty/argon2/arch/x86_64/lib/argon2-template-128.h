@@ -165,3 +165,9 @@ static void fill_segment_128(const argon2_instance_t *instance,
         }
     }
 }
+
+#define ARGON2_MULTI_STATE __m128i
+#define ARGON2_MULTI_WORDS ARGON2_OWORDS_IN_BLOCK
+#define ARGON2_MULTI_NAME  fill_segment_multi_128
+
+#include "argon2-template-multi.h"
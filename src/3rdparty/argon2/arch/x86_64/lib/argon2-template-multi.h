@@ -0,0 +1,127 @@
+/*
+ * Multi-instance fill_segment shared by the SIMD implementations.
+ *
+ * Fills the same segment of several independent instances with identical
+ * parameters one block at a time. The reference blocks of all instances are
+ * prefetched before the first compression, so that their (mostly L2) loads
+ * overlap with the compression of the preceding instances. With data
+ * independent addressing the address block is identical for every instance
+ * and is generated only once.
+ *
+ * The including file must define ARGON2_MULTI_STATE, ARGON2_MULTI_WORDS and
+ * ARGON2_MULTI_NAME and provide fill_block() and next_addresses().
+ */
+
+static void prefetch_block(const block *b)
+{
+    const char *p = (const char *)b->v;
+    unsigned int i;
+
+    for (i = 0; i < ARGON2_BLOCK_SIZE; i += 64) {
+        _mm_prefetch(p + i, _MM_HINT_T0);
+    }
+}
+
+static void ARGON2_MULTI_NAME(const argon2_instance_t *const *instances,
+                              uint32_t count, argon2_position_t position)
+{
+    const argon2_instance_t *instance;
+    block *ref_block[ARGON2_MAX_INSTANCES];
+    block address_block, input_block;
+    uint64_t pseudo_rand, ref_index, ref_lane;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i, k;
+    ARGON2_MULTI_STATE state[ARGON2_MAX_INSTANCES][ARGON2_MULTI_WORDS];
+    int data_independent_addressing, with_xor;
+
+    if (instances == NULL || count == 0 || count > ARGON2_MAX_INSTANCES) {
+        return;
+    }
+
+    instance = instances[0];
+
+    data_independent_addressing = (instance->type == Argon2_i) ||
+            (instance->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    /* version 1.2.1 and earlier: overwrite, not XOR */
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == instance->version);
+
+    if (data_independent_addressing) {
+        init_block_value(&input_block, 0);
+
+        input_block.v[0] = position.pass;
+        input_block.v[1] = position.lane;
+        input_block.v[2] = position.slice;
+        input_block.v[3] = instance->memory_blocks;
+        input_block.v[4] = instance->passes;
+        input_block.v[5] = instance->type;
+    }
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+
+        /* Don't forget to generate the first block of addresses: */
+        if (data_independent_addressing) {
+            next_addresses(&address_block, &input_block);
+        }
+    }
+
+    /* Offset of the current block */
+    curr_offset = position.lane * instance->lane_length +
+                  position.slice * instance->segment_length + starting_index;
+
+    if (0 == curr_offset % instance->lane_length) {
+        /* Last block in this lane */
+        prev_offset = curr_offset + instance->lane_length - 1;
+    } else {
+        /* Previous block */
+        prev_offset = curr_offset - 1;
+    }
+
+    for (k = 0; k < count; ++k) {
+        memcpy(state[k], ((instances[k]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    for (i = starting_index; i < instance->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        /*1.1 Rotating prev_offset if needed */
+        if (curr_offset % instance->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        if (data_independent_addressing && i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+            next_addresses(&address_block, &input_block);
+        }
+
+        position.index = i;
+
+        /* 1.2 Computing the index of the reference block for every instance */
+        for (k = 0; k < count; ++k) {
+            if (data_independent_addressing) {
+                pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+            } else {
+                pseudo_rand = instances[k]->memory[prev_offset].v[0];
+            }
+
+            ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+
+            if ((position.pass == 0) && (position.slice == 0)) {
+                /* Can not reference other lanes yet */
+                ref_lane = position.lane;
+            }
+
+            ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+            ref_block[k] = instances[k]->memory + instance->lane_length * ref_lane + ref_index;
+
+            prefetch_block(ref_block[k]);
+        }
+
+        /* 2 Creating the new blocks */
+        for (k = 0; k < count; ++k) {
+            fill_block(state[k], ref_block[k], instances[k]->memory + curr_offset, with_xor);
+        }
+    }
+}
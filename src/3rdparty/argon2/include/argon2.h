@@ -447,6 +447,24 @@ ARGON2_PUBLIC int argon2_select_impl_by_name(const char *name);
 
 ARGON2_PUBLIC size_t argon2_memory_size(uint32_t m_cost, uint32_t parallelism);
 
+/* Maximum number of independent hashes computed by one multi call */
+#define ARGON2_MAX_INSTANCES 4
+
+/**
+ * Computes @count independent Argon2id hashes with identical cost parameters,
+ * the memory filling of all instances is interleaved block by block.
+ * @param pwd, salt, hash, memory Arrays of @count pointers, one per instance
+ * @param count Number of instances, from 1 to ARGON2_MAX_INSTANCES
+ * @return ARGON2_OK if successful
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_ex_multi(const uint32_t t_cost,
+                                             const uint32_t m_cost,
+                                             const uint32_t parallelism,
+                                             const void *const *pwd, const size_t pwdlen,
+                                             const void *const *salt, const size_t saltlen,
+                                             void *const *hash, const size_t hashlen,
+                                             void *const *memory, const uint32_t count);
+
 /**
  * Function that performs memory-hard hashing with certain degree of parallelism
  * @param context       Pointer to the Argon2 internal structure
@@ -259,34 +259,109 @@ int argon2id_hash_raw(const uint32_t t_cost, const uint32_t m_cost,
                        ARGON2_VERSION_NUMBER);
 }
 
+static void argon2_init_context(argon2_context *context, const uint32_t t_cost,
+                                const uint32_t m_cost, const uint32_t parallelism,
+                                const void *pwd, const size_t pwdlen,
+                                const void *salt, const size_t saltlen,
+                                void *hash, const size_t hashlen) {
+    context->out = (uint8_t *)hash;
+    context->outlen = (uint32_t)hashlen;
+    context->pwd = CONST_CAST(uint8_t *)pwd;
+    context->pwdlen = (uint32_t)pwdlen;
+    context->salt = CONST_CAST(uint8_t *)salt;
+    context->saltlen = (uint32_t)saltlen;
+    context->secret = NULL;
+    context->secretlen = 0;
+    context->ad = NULL;
+    context->adlen = 0;
+    context->t_cost = t_cost;
+    context->m_cost = m_cost;
+    context->lanes = parallelism;
+    context->threads = parallelism;
+    context->allocate_cbk = NULL;
+    context->free_cbk = NULL;
+    context->flags = ARGON2_DEFAULT_FLAGS;
+    context->version = ARGON2_VERSION_NUMBER;
+}
+
 int argon2id_hash_raw_ex(const uint32_t t_cost, const uint32_t m_cost,
                          const uint32_t parallelism, const void *pwd,
                          const size_t pwdlen, const void *salt,
                          const size_t saltlen, void *hash, const size_t hashlen, void *memory) {
     argon2_context context;
 
-    context.out = (uint8_t *)hash;
-    context.outlen = (uint32_t)hashlen;
-    context.pwd = CONST_CAST(uint8_t *)pwd;
-    context.pwdlen = (uint32_t)pwdlen;
-    context.salt = CONST_CAST(uint8_t *)salt;
-    context.saltlen = (uint32_t)saltlen;
-    context.secret = NULL;
-    context.secretlen = 0;
-    context.ad = NULL;
-    context.adlen = 0;
-    context.t_cost = t_cost;
-    context.m_cost = m_cost;
-    context.lanes = parallelism;
-    context.threads = parallelism;
-    context.allocate_cbk = NULL;
-    context.free_cbk = NULL;
-    context.flags = ARGON2_DEFAULT_FLAGS;
-    context.version = ARGON2_VERSION_NUMBER;
+    argon2_init_context(&context, t_cost, m_cost, parallelism, pwd, pwdlen, salt, saltlen, hash, hashlen);
 
     return argon2_ctx_mem(&context, Argon2_id, memory, m_cost * 1024);
 }
 
+int argon2id_hash_raw_ex_multi(const uint32_t t_cost, const uint32_t m_cost,
+                               const uint32_t parallelism,
+                               const void *const *pwd, const size_t pwdlen,
+                               const void *const *salt, const size_t saltlen,
+                               void *const *hash, const size_t hashlen,
+                               void *const *memory, const uint32_t count) {
+    argon2_context context[ARGON2_MAX_INSTANCES];
+    argon2_instance_t instance[ARGON2_MAX_INSTANCES];
+    const argon2_instance_t *instances[ARGON2_MAX_INSTANCES];
+    uint32_t memory_blocks, segment_length, i;
+    int result;
+
+    if (count == 0 || count > ARGON2_MAX_INSTANCES) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    argon2_compute_memory_blocks(&memory_blocks, &segment_length, m_cost, parallelism);
+
+    /* m_cost is in KiB, so the preallocated memory is always block aligned */
+    if (memory_blocks > m_cost) {
+        return ARGON2_MEMORY_ALLOCATION_ERROR;
+    }
+
+    for (i = 0; i < count; ++i) {
+        argon2_init_context(&context[i], t_cost, m_cost, parallelism, pwd[i], pwdlen, salt[i], saltlen, hash[i], hashlen);
+
+        result = xmrig_ar2_validate_inputs(&context[i]);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        if (memory[i] == NULL) {
+            return ARGON2_MEMORY_ALLOCATION_ERROR;
+        }
+
+        instance[i].version = context[i].version;
+        instance[i].memory = (block *)memory[i];
+        instance[i].passes = context[i].t_cost;
+        instance[i].memory_blocks = memory_blocks;
+        instance[i].segment_length = segment_length;
+        instance[i].lane_length = segment_length * ARGON2_SYNC_POINTS;
+        instance[i].lanes = context[i].lanes;
+        instance[i].threads = ARGON2_MIN(context[i].threads, context[i].lanes);
+        instance[i].type = Argon2_id;
+        instance[i].print_internals = 0;
+        instance[i].keep_memory = 1;
+
+        result = xmrig_ar2_initialize(&instance[i], &context[i]);
+        if (ARGON2_OK != result) {
+            return result;
+        }
+
+        instances[i] = &instance[i];
+    }
+
+    result = xmrig_ar2_fill_memory_blocks_multi(instances, count);
+    if (ARGON2_OK != result) {
+        return result;
+    }
+
+    for (i = 0; i < count; ++i) {
+        xmrig_ar2_finalize(&context[i], &instance[i]);
+    }
+
+    return ARGON2_OK;
+}
+
 static int argon2_compare(const uint8_t *b1, const uint8_t *b2, size_t len) {
     size_t i;
     uint8_t d = 0U;
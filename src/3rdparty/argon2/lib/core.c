@@ -271,6 +271,31 @@ int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance) {
     return fill_memory_blocks_st(instance);
 }
 
+int xmrig_ar2_fill_memory_blocks_multi(const argon2_instance_t *const *instances, uint32_t count) {
+    const argon2_instance_t *instance;
+    uint32_t r, s, l;
+
+    if (instances == NULL || count == 0 || count > ARGON2_MAX_INSTANCES) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    instance = instances[0];
+    if (instance->lanes == 0) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (r = 0; r < instance->passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            for (l = 0; l < instance->lanes; ++l) {
+                argon2_position_t position = { r, l, (uint8_t)s, 0 };
+                xmrig_ar2_fill_segment_multi(instances, count, position);
+            }
+        }
+    }
+
+    return ARGON2_OK;
+}
+
 int xmrig_ar2_validate_inputs(const argon2_context *context) {
     if (NULL == context) {
         return ARGON2_INCORRECT_PARAMETER;
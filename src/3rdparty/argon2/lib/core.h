@@ -209,6 +209,15 @@ void xmrig_ar2_finalize(const argon2_context *context, argon2_instance_t *instan
  */
 void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t position);
 
+/*
+ * Fills the same segment of several instances with identical parameters,
+ * interleaving the instances block by block
+ * @param instances Array of @count instances
+ * @param count Number of instances, at most ARGON2_MAX_INSTANCES
+ * @param position Current position
+ */
+void xmrig_ar2_fill_segment_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position);
+
 /*
  * Function that fills the entire memory t_cost times based on the first two
  * blocks in each lane
@@ -217,4 +226,12 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
  */
 int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance);
 
+/*
+ * Multi-instance version of xmrig_ar2_fill_memory_blocks()
+ * @param instances Array of @count instances with identical parameters
+ * @param count Number of instances, at most ARGON2_MAX_INSTANCES
+ * @return ARGON2_OK if successful
+ */
+int xmrig_ar2_fill_memory_blocks_multi(const argon2_instance_t *const *instances, uint32_t count);
+
 #endif
@@ -8,6 +8,8 @@ typedef struct Argon2_impl {
     int (*check)(void);
     void (*fill_segment)(const argon2_instance_t *instance,
                          argon2_position_t position);
+    void (*fill_segment_multi)(const argon2_instance_t *const *instances,
+                               uint32_t count, argon2_position_t position);
 } argon2_impl;
 
 typedef struct Argon2_impl_list {
@@ -18,6 +20,8 @@ typedef struct Argon2_impl_list {
 void argon2_get_impl_list(argon2_impl_list *list);
 void fill_segment_default(const argon2_instance_t *instance,
                           argon2_position_t position);
+void fill_segment_multi_default(const argon2_instance_t *const *instances,
+                                uint32_t count, argon2_position_t position);
 
 #endif // ARGON2_IMPL_SELECT_H
 
@@ -35,12 +35,19 @@
 #include "base/io/log/Tags.h"
 #include "base/io/Signals.h"
 #include "base/kernel/Platform.h"
+#include "core/Autotune.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "Summary.h"
 #include "version.h"
 
 
+#ifdef XMRIG_FEATURE_BENCHMARK
+#   include "base/net/stratum/benchmark/BenchConfig.h"
+#   include "core/BenchSweep.h"
+#endif
+
+
 xmrig::App::App(Process *process)
 {
     m_controller = std::make_shared<Controller>(process);
@@ -50,6 +57,7 @@ xmrig::App::App(Process *process)
 xmrig::App::~App()
 {
     Cpu::release();
+    Log::destroy();
 }
 
 
@@ -88,10 +96,11 @@ int xmrig::App::exec()
     m_controller->pre_start();
     m_controller->config()->benchmark().set_controller(m_controller.get());
 
-    if (m_controller->config()->benchmark().isNewBenchRun() || m_controller->config()->isRebenchAlgo()) {
-        m_controller->config()->benchmark().start();
+    if (m_controller->config()->cpu().isAutotune()) {
+        m_autotune = std::make_shared<Autotune>(m_controller.get(), [this]() { start(); });
+        m_autotune->start();
     } else {
-        m_controller->start();
+        start();
     }
 
     rc = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
@@ -122,6 +131,11 @@ void xmrig::App::onSignal(int signum)
     case SIGINT:
         return close();
 
+#   ifdef SIGUSR1
+    case SIGUSR1:
+        return Log::flush();
+#   endif
+
     default:
         break;
     }
@@ -130,6 +144,8 @@ void xmrig::App::onSignal(int signum)
 
 void xmrig::App::close()
 {
+    m_autotune.reset();
+    m_sweep.reset();
     m_signals.reset();
     m_console.reset();
 
@@ -137,3 +153,22 @@ void xmrig::App::close()
 
     Log::destroy();
 }
+
+
+void xmrig::App::start()
+{
+#   ifdef XMRIG_FEATURE_BENCHMARK
+    const auto &benchmark = m_controller->config()->pools().benchmark();
+    if (benchmark && benchmark->isSweep()) {
+        m_sweep = std::make_shared<BenchSweep>(m_controller.get(), benchmark);
+
+        return m_sweep->start();
+    }
+#   endif
+
+    if (m_controller->config()->benchmark().isNewBenchRun() || m_controller->config()->isRebenchAlgo()) {
+        m_controller->config()->benchmark().start();
+    } else {
+        m_controller->start();
+    }
+}
@@ -38,6 +38,8 @@
 namespace xmrig {
 
 
+class Autotune;
+class BenchSweep;
 class Console;
 class Controller;
 class Network;
@@ -62,7 +64,10 @@ protected:
 private:
     bool background(int &rc);
     void close();
+    void start();
 
+    std::shared_ptr<Autotune> m_autotune;
+    std::shared_ptr<BenchSweep> m_sweep;
     std::shared_ptr<Console> m_console;
     std::shared_ptr<Controller> m_controller;
     std::shared_ptr<Signals> m_signals;
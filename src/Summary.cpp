@@ -22,8 +22,11 @@
 
 
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/Cgroup.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Startup.h"
 #include "base/net/stratum/Pool.h"
+#include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "crypto/common/Assembly.h"
@@ -111,6 +114,22 @@ static void print_cpu(const Config *)
 #   else
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("threads:") CYAN_BOLD("%zu"), "", info->threads());
 #   endif
+
+    if (Cgroup::isLimited()) {
+        char quota[16] = "none";
+        if (Cgroup::quota() > 0.0) {
+            snprintf(quota, sizeof(quota), "%.2f", Cgroup::quota());
+        }
+
+        Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("cgroup v%u quota:") CYAN_BOLD("%s") BLACK_BOLD(" cpuset:") CYAN_BOLD("%s")
+                   BLACK_BOLD(" usable:") CYAN_BOLD("%zu") "T",
+                   "",
+                   Cgroup::version(),
+                   quota,
+                   Cgroup::cpusetList().isNull() ? "all" : Cgroup::cpusetList().data(),
+                   Cgroup::cpus(info->threads())
+                   );
+    }
 }
 
 
@@ -135,7 +154,11 @@ static void print_memory(const Config *config)
     }
 
     DmiReader reader;
-    if (!reader.read()) {
+    const uint64_t ts = Chrono::steadyMSecs();
+    const bool rc     = reader.read();
+    Startup::set(Startup::DMI, Chrono::steadyMSecs() - ts);
+
+    if (!rc) {
         return;
     }
 
@@ -185,6 +208,12 @@ static void print_threads(const Config *config)
 }
 
 
+static void print_startup(const Config *)
+{
+    Startup::print();
+}
+
+
 static void print_commands(Config *)
 {
     if (Log::isColors()) {
@@ -214,6 +243,7 @@ void xmrig::Summary::print(Controller *controller)
     print_memory(config);
     print_threads(config);
     config->pools().print();
+    print_startup(config);
 
     print_commands(config);
 }
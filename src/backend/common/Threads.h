@@ -60,6 +60,12 @@ public:
         return count;
     }
 
+    inline void set(const String &profile, T &&threads)
+    {
+        m_profiles.erase(profile);
+        m_profiles.insert({ profile, std::move(threads) });
+    }
+
     const T &get(const String &profileName) const;
     size_t read(const rapidjson::Value &value);
     String profileName(const Algorithm &algorithm, bool strict = false) const;
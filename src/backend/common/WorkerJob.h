@@ -27,6 +27,7 @@
 
 
 #include <cstring>
+#include <memory>
 
 
 #include "base/net/stratum/Job.h"
@@ -48,20 +49,29 @@ public:
     inline uint8_t index() const            { return m_index; }
 
 
-    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline void add(const std::shared_ptr<const Job> &snapshot, uint32_t reserveCount, Nonce::Backend backend)
     {
         m_sequence = Nonce::sequence(backend);
 
+        if (snapshot == m_snapshots[index()]) {
+            return;
+        }
+
+        const Job &job = *snapshot;
+
         if (currentJob() == job) {
+            m_snapshots[index()] = snapshot;
             return;
         }
 
         if (index() == 1 && job.index() == 0 && job == m_jobs[0]) {
-            m_index = 0;
+            m_index        = 0;
+            m_snapshots[0] = snapshot;
             return;
         }
 
         save(job, reserveCount, backend);
+        m_snapshots[index()] = snapshot;
     }
 
 
@@ -111,6 +121,7 @@ private:
 
     alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
     Job m_jobs[2];
+    std::shared_ptr<const Job> m_snapshots[2];
     uint32_t m_rounds[2] = { 0, 0 };
     uint64_t m_nonce_mask[2] = { 0, 0 };
     uint64_t m_sequence  = 0;
@@ -131,7 +131,8 @@ void xmrig::BenchState::init(IBenchListener *listener, uint32_t size)
 {
     assert(d_ptr == nullptr);
 
-    d_ptr = new BenchStatePrivate(listener, size);
+    d_ptr  = new BenchStatePrivate(listener, size);
+    m_data = 0;
 }
 
 
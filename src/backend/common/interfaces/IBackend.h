@@ -33,6 +33,7 @@ namespace xmrig {
 class Algorithm;
 class Benchmark;
 class Hashrate;
+class HugePagesInfo;
 class IApiRequest;
 class IWorker;
 class Job;
@@ -51,6 +52,7 @@ public:
     virtual bool isEnabled(const Algorithm &algorithm) const            = 0;
     virtual bool tick(uint64_t ticks)                                   = 0;
     virtual const Hashrate *hashrate() const                            = 0;
+    virtual HugePagesInfo hugePages() const                             = 0;
     virtual const String &profileName() const                           = 0;
     virtual const String &type() const                                  = 0;
     virtual void execCommand(char command)                              = 0;
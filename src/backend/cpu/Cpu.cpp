@@ -22,6 +22,8 @@
 
 #include "backend/cpu/Cpu.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/kernel/Startup.h"
+#include "base/tools/Chrono.h"
 
 
 #if defined(XMRIG_FEATURE_HWLOC)
@@ -32,16 +34,21 @@
 
 
 static xmrig::ICpuInfo *cpuInfo = nullptr;
+static xmrig::String topologyCache;
 
 
 xmrig::ICpuInfo *xmrig::Cpu::info()
 {
     if (cpuInfo == nullptr) {
+        const uint64_t ts = Chrono::steadyMSecs();
+
 #       if defined(XMRIG_FEATURE_HWLOC)
-        cpuInfo = new HwlocCpuInfo();
+        cpuInfo = new HwlocCpuInfo(topologyCache);
 #       else
         cpuInfo = new BasicCpuInfo();
 #       endif
+
+        Startup::set(Startup::TOPOLOGY, Chrono::steadyMSecs() - ts);
     }
 
     return cpuInfo;
@@ -59,3 +66,9 @@ void xmrig::Cpu::release()
     delete cpuInfo;
     cpuInfo = nullptr;
 }
+
+
+void xmrig::Cpu::setTopologyCache(const String &dir)
+{
+    topologyCache = dir;
+}
@@ -21,6 +21,7 @@
 
 
 #include "backend/cpu/interfaces/ICpuInfo.h"
+#include "base/tools/String.h"
 
 
 namespace xmrig {
@@ -32,6 +33,7 @@ public:
     static ICpuInfo *info();
     static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void release();
+    static void setTopologyCache(const String &dir);
 
     inline static Assembly::Id assembly(Assembly::Id hint) { return hint == Assembly::AUTO ? Cpu::info()->assembly() : hint; }
 };
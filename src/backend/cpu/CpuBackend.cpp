@@ -16,6 +16,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <memory>
 #include <mutex>
 
 
@@ -26,13 +27,16 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/CoreTelemetry.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Startup.h"
 #include "base/net/stratum/Job.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesBudget.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -48,6 +52,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
@@ -111,6 +120,9 @@ public:
             return;
         }
 
+        const uint64_t elapsed = Chrono::steadyMSecs() - m_ts;
+        const bool startup     = Startup::set(Startup::THREADS, elapsed);
+
         LOG_INFO("%s" GREEN_BOLD(" READY") " threads %s%zu/%zu (%zu)" CLEAR " huge pages %s%1.0f%% %zu/%zu" CLEAR " memory " CYAN_BOLD("%zu KB") BLACK_BOLD(" (%" PRIu64 " ms)"),
                  Tags::cpu(),
                  m_errors == 0 ? CYAN_BOLD_S : YELLOW_BOLD_S,
@@ -119,8 +131,13 @@ public:
                  m_hugePages.percent(),
                  m_hugePages.allocated, m_hugePages.total,
                  memory() / 1024,
-                 Chrono::steadyMSecs() - m_ts
+                 elapsed
                  );
+
+        // The summary is printed before the threads and the RandomX dataset are ready, repeat the line with all phases.
+        if (startup) {
+            Startup::print();
+        }
     }
 
 private:
@@ -170,6 +187,27 @@ public:
     }
 
 
+    void updateTelemetry(const CpuConfig &cpu, bool restart)
+    {
+        const String root = cpu.telemetryRoot().isEmpty() ? String(CoreTelemetry::kDefaultRoot) : cpu.telemetryRoot();
+
+        if (!cpu.isTelemetry() || threads.empty() || (telemetry && (restart || telemetry->root() != root))) {
+            telemetry.reset();
+        }
+
+        if (cpu.isTelemetry() && !threads.empty() && !telemetry) {
+            std::vector<int64_t> affinities;
+            affinities.reserve(threads.size());
+
+            for (const auto &data : threads) {
+                affinities.emplace_back(data.affinity);
+            }
+
+            telemetry.reset(new CoreTelemetry(root, affinities));
+        }
+    }
+
+
     rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
     {
         HugePagesInfo pages;
@@ -205,6 +243,7 @@ public:
     Controller *controller;
     CpuLaunchStatus status;
     std::vector<CpuLaunchData> threads;
+    std::unique_ptr<CoreTelemetry> telemetry;
     String profileName;
     Workers<CpuLaunchData> workers;
 
@@ -251,6 +290,10 @@ xmrig::CpuBackend::CpuBackend(Controller *controller) :
 xmrig::CpuBackend::~CpuBackend()
 {
     delete d_ptr;
+
+#   ifdef XMRIG_FEATURE_ASM
+    CnRCache::release();
+#   endif
 }
 
 
@@ -268,6 +311,10 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+    if (d_ptr->telemetry && (ticks % 2) == 0) {
+        d_ptr->telemetry->tick(Chrono::steadyMSecs());
+    }
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -278,6 +325,14 @@ const xmrig::Hashrate *xmrig::CpuBackend::hashrate() const
 }
 
 
+xmrig::HugePagesInfo xmrig::CpuBackend::hugePages() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return d_ptr->status.hugePages();
+}
+
+
 const xmrig::String &xmrig::CpuBackend::profileName() const
 {
     return d_ptr->profileName;
@@ -309,7 +364,15 @@ void xmrig::CpuBackend::prepare(const Job &nextJob)
 
 void xmrig::CpuBackend::printHashrate(bool details)
 {
-    if (!details || !hashrate()) {
+    if (!hashrate()) {
+        return;
+    }
+
+    if (d_ptr->telemetry && (details || Log::isVerbose())) {
+        d_ptr->telemetry->print(hashrate());
+    }
+
+    if (!details) {
         return;
     }
 
@@ -352,8 +415,16 @@ void xmrig::CpuBackend::setJob(const Job &job)
     const auto &cpu = d_ptr->controller->config()->cpu();
 
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
+
+#   ifdef XMRIG_FEATURE_ASM
+    // Generate CN-R code for this and the next height before workers need it.
+    for (const auto &data : threads) {
+        CnRCache::prepare(job.algorithm(), job.height(), data.av(), Cpu::assembly(data.assembly));
+    }
+#   endif
+
     if (!d_ptr->threads.empty() && d_ptr->threads.size() == threads.size() && std::equal(d_ptr->threads.begin(), d_ptr->threads.end(), threads.begin())) {
-        return;
+        return d_ptr->updateTelemetry(cpu, false);
     }
 
     d_ptr->algo         = job.algorithm();
@@ -375,6 +446,7 @@ void xmrig::CpuBackend::setJob(const Job &job)
 
     d_ptr->threads = std::move(threads);
     d_ptr->start();
+    d_ptr->updateTelemetry(cpu, true);
 }
 
 
@@ -404,6 +476,7 @@ void xmrig::CpuBackend::stop()
 
     d_ptr->workers.stop();
     d_ptr->threads.clear();
+    d_ptr->telemetry.reset();
 
     LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::cpu(), Chrono::steadyMSecs() - ts);
 }
@@ -455,6 +528,10 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        if (d_ptr->telemetry) {
+            thread.AddMember("telemetry", d_ptr->telemetry->toJSON(i, hashrate(), doc), allocator);
+        }
+
         i++;
         threads.PushBack(thread, allocator);
     }
@@ -468,7 +545,8 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 void xmrig::CpuBackend::handleRequest(IApiRequest &request)
 {
     if (request.type() == IApiRequest::REQ_SUMMARY) {
-        request.reply().AddMember("hugepages", d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
+        request.reply().AddMember("hugepages",        d_ptr->hugePages(request.version(), request.doc()), request.doc().GetAllocator());
+        request.reply().AddMember("hugepages_budget", HugePagesBudget::toJSON(request.doc()), request.doc().GetAllocator());
     }
 }
 #endif
@@ -50,6 +50,7 @@ protected:
     bool isEnabled(const Algorithm &algorithm) const override;
     bool tick(uint64_t ticks) override;
     const Hashrate *hashrate() const override;
+    HugePagesInfo hugePages() const override;
     const String &profileName() const override;
     const String &type() const override;
     void prepare(const Job &nextJob) override;
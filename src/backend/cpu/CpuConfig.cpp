@@ -20,13 +20,17 @@
 #include "3rdparty/rapidjson/document.h"
 #include "backend/cpu/CpuConfig_gen.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/platform/Cgroup.h"
 #include "base/io/json/Json.h"
+#include "base/kernel/Process.h"
 
 #include <algorithm>
 
 
 namespace xmrig {
 
+const char *CpuConfig::kAutotune            = "autotune";
+const char *CpuConfig::kCgroupRoot          = "cgroup-root";
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
 const char *CpuConfig::kHugePages           = "huge-pages";
@@ -35,6 +39,9 @@ const char *CpuConfig::kHwAes               = "hw-aes";
 const char *CpuConfig::kMaxThreadsHint      = "max-threads-hint";
 const char *CpuConfig::kMemoryPool          = "memory-pool";
 const char *CpuConfig::kPriority            = "priority";
+const char *CpuConfig::kTelemetry           = "telemetry";
+const char *CpuConfig::kTelemetryRoot       = "telemetry-root";
+const char *CpuConfig::kTopologyCache       = "topology-cache";
 const char *CpuConfig::kYield               = "yield";
 
 #ifdef XMRIG_FEATURE_ASM
@@ -71,6 +78,12 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kPriority),     priority() != -1 ? Value(priority()) : Value(kNullType), allocator);
     obj.AddMember(StringRef(kMemoryPool),   m_memoryPool < 1 ? Value(m_memoryPool < 0) : Value(m_memoryPool), allocator);
     obj.AddMember(StringRef(kYield),        m_yield, allocator);
+    obj.AddMember(StringRef(kAutotune),     m_autotune, allocator);
+
+    obj.AddMember(StringRef(kCgroupRoot),   m_cgroupRoot.toJSON(), allocator);
+    obj.AddMember(StringRef(kTelemetry),    m_telemetry, allocator);
+    obj.AddMember(StringRef(kTelemetryRoot), m_telemetryRoot.toJSON(), allocator);
+    obj.AddMember(StringRef(kTopologyCache), m_topologyCache.isNull() ? Value(false) : (m_topologyCache.isEmpty() ? Value(true) : m_topologyCache.toJSON()), allocator);
 
     if (m_threads.isEmpty()) {
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
@@ -131,14 +144,20 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
 {
     if (value.IsObject()) {
         m_enabled      = Json::getBool(value, kEnabled, m_enabled);
+        m_autotune     = Json::getBool(value, kAutotune, m_autotune);
         m_hugePagesJit = Json::getBool(value, kHugePagesJit, m_hugePagesJit);
         m_limit        = Json::getUint(value, kMaxThreadsHint, m_limit);
+        m_cgroupRoot   = Json::getString(value, kCgroupRoot);
         m_yield        = Json::getBool(value, kYield, m_yield);
 
+        m_telemetry     = Json::getBool(value, kTelemetry, m_telemetry);
+        m_telemetryRoot = Json::getString(value, kTelemetryRoot);
+
         setAesMode(Json::getValue(value, kHwAes));
         setHugePages(Json::getValue(value, kHugePages));
         setMemoryPool(Json::getValue(value, kMemoryPool));
         setPriority(Json::getInt(value,  kPriority, -1));
+        setTopologyCache(Json::getValue(value, kTopologyCache));
 
 #       ifdef XMRIG_FEATURE_ASM
         m_assembly = Json::getValue(value, kAsm);
@@ -163,8 +182,40 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
 }
 
 
+void xmrig::CpuConfig::setHugePages(bool enable)
+{
+    if (enable != isHugePages()) {
+        m_hugePageSize = enable ? kDefaultHugePageSizeKb : 0U;
+    }
+}
+
+
+void xmrig::CpuConfig::setThreads(const String &profile, CpuThreads &&threads)
+{
+    m_threads.set(profile, std::move(threads));
+    m_shouldSave = true;
+}
+
+
+void xmrig::CpuConfig::setTopologyCache(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_topologyCache = value.GetBool() ? "" : nullptr;
+    }
+    else if (value.IsString()) {
+        m_topologyCache = value.GetString();
+    }
+    else {
+        m_topologyCache = nullptr;
+    }
+}
+
+
 void xmrig::CpuConfig::generate()
 {
+    Cgroup::init(m_cgroupRoot);
+    Cpu::setTopologyCache((m_topologyCache.isEmpty() && !m_topologyCache.isNull()) ? Process::location(Process::DataLocation) : m_topologyCache);
+
     if (!isEnabled() || m_threads.has("*")) {
         return;
     }
@@ -38,6 +38,8 @@ public:
         AES_SOFT
     };
 
+    static const char *kAutotune;
+    static const char *kCgroupRoot;
     static const char *kEnabled;
     static const char *kField;
     static const char *kHugePages;
@@ -46,6 +48,9 @@ public:
     static const char *kMaxThreadsHint;
     static const char *kMemoryPool;
     static const char *kPriority;
+    static const char *kTelemetry;
+    static const char *kTelemetryRoot;
+    static const char *kTopologyCache;
     static const char *kYield;
 
 #   ifdef XMRIG_FEATURE_ASM
@@ -63,19 +68,29 @@ public:
     size_t memPoolSize() const;
     std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
     void read(const rapidjson::Value &value);
+    void setHugePages(bool enable);
+    void setThreads(const String &profile, CpuThreads &&threads);
+
+    inline bool isAutotune() const                      { return m_autotune; }
 
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
+    inline bool isTelemetry() const                     { return m_telemetry; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
+    inline const String &cgroupRoot() const             { return m_cgroupRoot; }
+    inline const String &telemetryRoot() const          { return m_telemetryRoot; }
+    inline const String &topologyCache() const          { return m_topologyCache; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
     inline uint32_t limit() const                       { return m_limit; }
 
+    inline void setAutotune(bool enable)                { m_shouldSave |= m_autotune != enable; m_autotune = enable; }
+
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
     constexpr static size_t kOneGbPageSizeKb        = 1048576U;
@@ -85,18 +100,25 @@ private:
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
 
+    void setTopologyCache(const rapidjson::Value &value);
+
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
+    bool m_autotune         = false;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
     bool m_shouldSave       = false;
+    bool m_telemetry        = false;
     bool m_yield            = true;
     int m_memoryPool        = 0;
     int m_priority          = -1;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
     String m_argon2Impl;
+    String m_cgroupRoot;
+    String m_telemetryRoot;
+    String m_topologyCache;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
 };
@@ -24,6 +24,7 @@
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuWorker.h"
 #include "base/tools/Alignment.h"
+#include "base/kernel/Startup.h"
 #include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
@@ -149,6 +150,18 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
 
 template<size_t N>
 bool xmrig::CpuWorker<N>::selfTest()
+{
+    const uint64_t ts = Chrono::steadyMSecs();
+    const bool rc     = test();
+
+    Startup::setMax(Startup::SELF_TEST, Chrono::steadyMSecs() - ts);
+
+    return rc;
+}
+
+
+template<size_t N>
+bool xmrig::CpuWorker<N>::test()
 {
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_algorithm.family() == Algorithm::RANDOM_X) {
@@ -498,10 +511,10 @@ void xmrig::CpuWorker<N>::consumeJob()
         return;
     }
 
-    auto job = m_miner->job();
+    const auto job = m_miner->job();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    m_benchSize          = job.benchSize();
+    m_benchSize          = job->benchSize();
     const uint32_t count = m_benchSize ? 1U : kReserveCount;
 #   else
     constexpr uint32_t count = kReserveCount;
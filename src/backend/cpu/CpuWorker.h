@@ -78,6 +78,7 @@ private:
 #   endif
 
     bool nextRound();
+    bool test();
     bool verify(const Algorithm &algorithm, const uint8_t *referenceValue);
     bool verify2(const Algorithm &algorithm, const uint8_t *referenceValue);
     void allocateCnCtx();
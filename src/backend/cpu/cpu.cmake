@@ -9,6 +9,8 @@ set(HEADERS_BACKEND_CPU
     src/backend/cpu/CpuWorker.h
     src/backend/cpu/interfaces/ICpuInfo.h
     src/backend/cpu/platform/BasicCpuInfo.h
+    src/backend/cpu/platform/Cgroup.h
+    src/backend/cpu/platform/CoreTelemetry.h
    )
 
 set(SOURCES_BACKEND_CPU
@@ -19,6 +21,8 @@ set(SOURCES_BACKEND_CPU
     src/backend/cpu/CpuThread.cpp
     src/backend/cpu/CpuThreads.cpp
     src/backend/cpu/CpuWorker.cpp
+    src/backend/cpu/platform/Cgroup.cpp
+    src/backend/cpu/platform/CoreTelemetry.cpp
    )
 
 if (WITH_HWLOC)
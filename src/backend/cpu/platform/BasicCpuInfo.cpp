@@ -38,6 +38,7 @@
 
 #include "backend/cpu/platform/BasicCpuInfo.h"
 #include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/platform/Cgroup.h"
 #include "crypto/common/Assembly.h"
 
 
@@ -303,6 +304,7 @@ xmrig::BasicCpuInfo::BasicCpuInfo() :
 
     cn_sse41_enabled = has(FLAG_SSE41);
     cn_vaes_enabled = has(FLAG_VAES);
+    cn_vperm_enabled = has(FLAG_SSSE3);
 }
 
 
@@ -314,7 +316,7 @@ const char *xmrig::BasicCpuInfo::backend() const
 
 xmrig::CpuThreads xmrig::BasicCpuInfo::threads(const Algorithm &algorithm, uint32_t) const
 {
-    const size_t count = std::thread::hardware_concurrency();
+    const size_t count = Cgroup::cpus(std::thread::hardware_concurrency());
 
     if (count == 1) {
         return 1;
@@ -395,6 +397,7 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
     out.AddMember("packages",   static_cast<uint64_t>(packages()), allocator);
     out.AddMember("nodes",      static_cast<uint64_t>(nodes()), allocator);
     out.AddMember("backend",    StringRef(backend()), allocator);
+    out.AddMember("cgroup",     Cgroup::toJSON(doc), allocator);
 
 #   ifdef XMRIG_FEATURE_MSR
     out.AddMember("msr",        StringRef(msrNames[msrMod()]), allocator);
@@ -41,6 +41,7 @@
 
 #include "backend/cpu/platform/BasicCpuInfo.h"
 #include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/platform/Cgroup.h"
 
 
 #if defined(XMRIG_OS_UNIX)
@@ -103,11 +104,11 @@ xmrig::CpuThreads xmrig::BasicCpuInfo::threads(const Algorithm &algorithm, uint3
 {
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if (algorithm.family() == Algorithm::GHOSTRIDER) {
-        return CpuThreads(threads(), 8);
+        return CpuThreads(Cgroup::cpus(threads()), 8);
     }
 #   endif
 
-    return CpuThreads(threads());
+    return CpuThreads(Cgroup::cpus(threads()));
 }
 
 
@@ -130,6 +131,7 @@ rapidjson::Value xmrig::BasicCpuInfo::toJSON(rapidjson::Document &doc) const
     out.AddMember("packages",   static_cast<uint64_t>(packages()), allocator);
     out.AddMember("nodes",      static_cast<uint64_t>(nodes()), allocator);
     out.AddMember("backend",    StringRef(backend()), allocator);
+    out.AddMember("cgroup",     Cgroup::toJSON(doc), allocator);
     out.AddMember("msr",        "none", allocator);
     out.AddMember("assembly",   "none", allocator);
 
@@ -0,0 +1,278 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/platform/Cgroup.h"
+#include "3rdparty/rapidjson/document.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+
+namespace xmrig {
+
+
+const char *Cgroup::kDefaultRoot = "/sys/fs/cgroup";
+
+double Cgroup::m_quota          = 0.0;
+std::vector<int32_t> Cgroup::m_cpuset;
+String Cgroup::m_cpusetList;
+uint32_t Cgroup::m_version      = 0;
+
+
+#ifdef XMRIG_OS_LINUX
+static bool isFile(const std::string &path)
+{
+    return std::ifstream(path).good();
+}
+
+
+static std::string readLine(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+
+    if (file) {
+        std::getline(file, line);
+    }
+
+    return line;
+}
+
+
+// Calls the callback for every directory from the process cgroup up to the hierarchy root, stops when it returns true.
+template<typename Callback>
+static void walk(const std::string &base, std::string path, Callback callback)
+{
+    while (true) {
+        if (callback(base + path)) {
+            return;
+        }
+
+        if (path.empty() || path == "/") {
+            return;
+        }
+
+        const size_t pos = path.find_last_of('/');
+        path.resize(pos == std::string::npos ? 0 : pos);
+    }
+}
+
+
+static double readQuotaV1(const std::string &dir)
+{
+    const std::string quota  = readLine(dir + "/cpu.cfs_quota_us");
+    const std::string period = readLine(dir + "/cpu.cfs_period_us");
+
+    if (quota.empty() || period.empty() || quota[0] == '-') {
+        return 0.0;
+    }
+
+    const double value = strtod(period.c_str(), nullptr);
+
+    return value > 0.0 ? strtod(quota.c_str(), nullptr) / value : 0.0;
+}
+
+
+static double readQuotaV2(const std::string &dir)
+{
+    std::istringstream stream(readLine(dir + "/cpu.max"));
+    std::string quota;
+    double period = 0.0;
+
+    if (!(stream >> quota >> period) || quota == "max" || period <= 0.0) {
+        return 0.0;
+    }
+
+    return strtod(quota.c_str(), nullptr) / period;
+}
+
+
+static std::vector<int32_t> parseList(const std::string &list)
+{
+    std::vector<int32_t> out;
+    std::istringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+
+        const size_t pos  = range.find('-');
+        const long first  = strtol(range.c_str(), nullptr, 10);
+        const long last   = pos == std::string::npos ? first : strtol(range.c_str() + pos + 1, nullptr, 10);
+
+        for (long i = first; i <= last && i >= 0; ++i) {
+            out.emplace_back(static_cast<int32_t>(i));
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+
+    return out;
+}
+#endif
+
+
+} // namespace xmrig
+
+
+bool xmrig::Cgroup::isAllowed(int64_t cpu)
+{
+    return m_cpuset.empty() || std::binary_search(m_cpuset.begin(), m_cpuset.end(), static_cast<int32_t>(cpu));
+}
+
+
+rapidjson::Value xmrig::Cgroup::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    if (!isLimited()) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+    Value out(kObjectType);
+
+    out.AddMember("version",     m_version, allocator);
+    out.AddMember("quota",       m_quota > 0.0 ? Value(m_quota) : Value(kNullType), allocator);
+    out.AddMember("cpuset",      m_cpusetList.toJSON(), allocator);
+    out.AddMember("max_threads", static_cast<uint64_t>(cpus(std::thread::hardware_concurrency())), allocator);
+
+    return out;
+}
+
+
+size_t xmrig::Cgroup::cpus(size_t count)
+{
+    if (!m_cpuset.empty()) {
+        count = std::min(count, m_cpuset.size());
+    }
+
+    const uint32_t max = maxThreads();
+    if (max) {
+        count = std::min<size_t>(count, max);
+    }
+
+    return std::max<size_t>(count, 1);
+}
+
+
+uint32_t xmrig::Cgroup::maxThreads()
+{
+    return m_quota > 0.0 ? std::max(static_cast<uint32_t>(std::floor(m_quota + 0.01)), 1U) : 0;
+}
+
+
+void xmrig::Cgroup::init(const char *root)
+{
+    m_quota      = 0.0;
+    m_version    = 0;
+    m_cpusetList = nullptr;
+    m_cpuset.clear();
+
+#   ifdef XMRIG_OS_LINUX
+    const std::string base((root && *root) ? root : kDefaultRoot);
+
+    std::string unified;
+    std::string cpuController   = "cpu";
+    std::string cpuPath;
+    std::string cpusetPath;
+
+    std::ifstream self("/proc/self/cgroup");
+    std::string line;
+
+    while (std::getline(self, line)) {
+        const size_t first  = line.find(':');
+        const size_t second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+
+        const std::string controllers = line.substr(first + 1, second - first - 1);
+        const std::string path        = line.substr(second + 1);
+
+        if (controllers.empty()) {
+            unified = path;
+            continue;
+        }
+
+        std::istringstream stream(controllers);
+        std::string name;
+
+        while (std::getline(stream, name, ',')) {
+            if (name == "cpu") {
+                cpuController = controllers;
+                cpuPath       = path;
+            }
+            else if (name == "cpuset") {
+                cpusetPath = path;
+            }
+        }
+    }
+
+    std::string cpuset;
+    auto setQuota = [](double quota) {
+        if (quota > 0.0 && (m_quota <= 0.0 || quota < m_quota)) {
+            m_quota = quota;
+        }
+    };
+
+    if (isFile(base + "/cgroup.controllers")) {
+        m_version = 2;
+
+        walk(base, unified, [&setQuota](const std::string &dir) { setQuota(readQuotaV2(dir)); return false; });
+        walk(base, unified, [&cpuset](const std::string &dir) { cpuset = readLine(dir + "/cpuset.cpus.effective"); return !cpuset.empty(); });
+    }
+    else {
+        m_version = 1;
+
+        const std::string cpuBase = isFile(base + "/" + cpuController + "/cpu.cfs_period_us") ? base + "/" + cpuController : base + "/cpu";
+
+        walk(cpuBase, cpuPath, [&setQuota](const std::string &dir) { setQuota(readQuotaV1(dir)); return false; });
+        walk(base + "/cpuset", cpusetPath, [&cpuset](const std::string &dir) {
+            cpuset = readLine(dir + "/cpuset.effective_cpus");
+            if (cpuset.empty()) {
+                cpuset = readLine(dir + "/cpuset.cpus");
+            }
+
+            return !cpuset.empty();
+        });
+    }
+
+    m_cpuset = parseList(cpuset);
+
+    // The root cpuset lists every CPU, only a subset of the online CPUs is a restriction.
+    if (m_cpuset.size() >= std::thread::hardware_concurrency()) {
+        m_cpuset.clear();
+    }
+    else if (!m_cpuset.empty()) {
+        m_cpusetList = cpuset.c_str();
+    }
+
+    if (!isLimited()) {
+        m_version = 0;
+    }
+#   endif
+}
@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CGROUP_H
+#define XMRIG_CGROUP_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Effective CPU limits of the process cgroup (v1 or v2): CFS quota and cpuset, the most restrictive values found
+// between the process cgroup and the hierarchy root are used. Limits are empty on other operating systems.
+class Cgroup
+{
+public:
+    static const char *kDefaultRoot;
+
+    static inline bool isLimited()                          { return m_quota > 0.0 || !m_cpuset.empty(); }
+    static inline const String &cpusetList()                { return m_cpusetList; }
+    static inline double quota()                            { return m_quota; }
+    static inline uint32_t version()                        { return m_version; }
+
+    static bool isAllowed(int64_t cpu);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static size_t cpus(size_t count);
+    static uint32_t maxThreads();
+    static void init(const char *root);
+
+private:
+    static double m_quota;
+    static std::vector<int32_t> m_cpuset;
+    static String m_cpusetList;
+    static uint32_t m_version;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CGROUP_H */
@@ -0,0 +1,251 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/cpu/platform/CoreTelemetry.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+
+namespace xmrig {
+
+
+const char *CoreTelemetry::kDefaultRoot = "/sys/devices/system/cpu";
+
+
+static const char *kThrottleCount[CoreTelemetry::ThrottleMax] = {
+    "thermal_throttle/core_throttle_count",
+    "thermal_throttle/package_throttle_count"
+};
+
+static const char *kThrottleTime = "thermal_throttle/core_throttle_total_time_ms";
+
+
+static bool readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+
+    return file.is_open() && (file >> value);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CoreTelemetry::CoreTelemetry(const String &root, const std::vector<int64_t> &affinities) :
+    m_root(root),
+    m_freq(affinities.size()),
+    m_throttled(affinities.size())
+{
+    size_t freq     = 0;
+    size_t thermal  = 0;
+
+    m_cores.resize(affinities.size());
+
+    for (size_t i = 0; i < affinities.size(); ++i) {
+        Core &core = m_cores[i];
+        core.cpu   = affinities[i];
+
+        // Threads without affinity may migrate between CPUs, there is nothing meaningful to sample for them.
+        if (core.cpu < 0) {
+            continue;
+        }
+
+        core.path = std::string(m_root.data()) + "/cpu" + std::to_string(core.cpu) + "/";
+
+        uint64_t value = 0;
+        if (readValue(core.path + "cpufreq/scaling_cur_freq", value)) {
+            core.freqFile = core.path + "cpufreq/scaling_cur_freq";
+        }
+        else if (readValue(core.path + "cpufreq/cpuinfo_cur_freq", value)) {
+            core.freqFile = core.path + "cpufreq/cpuinfo_cur_freq";
+        }
+
+        if (!core.freqFile.empty()) {
+            readValue(core.path + "cpufreq/cpuinfo_max_freq", core.max);
+            core.cur = value;
+            ++freq;
+        }
+
+        core.thermal = readValue(core.path + kThrottleCount[CoreThrottle], core.throttleStart[CoreThrottle]);
+        if (core.thermal) {
+            readValue(core.path + kThrottleCount[PackageThrottle], core.throttleStart[PackageThrottle]);
+            readValue(core.path + kThrottleTime, core.throttleTimeStart);
+            ++thermal;
+        }
+    }
+
+    m_enabled = freq > 0 || thermal > 0;
+
+    if (!m_enabled) {
+        LOG_WARN("%s " YELLOW("telemetry: no readable cpufreq or thermal throttle counters in ") YELLOW_BOLD("%s"), Tags::cpu(), m_root.data());
+
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("telemetry") " cpufreq " CYAN_BOLD("%zu") " thermal throttle " CYAN_BOLD("%zu") " of " CYAN_BOLD("%zu") " thread(s)",
+             Tags::cpu(), freq, thermal, affinities.size());
+}
+
+
+void xmrig::CoreTelemetry::print(const Hashrate *hashrate) const
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    char num[8 * 3] = { 0 };
+    char thr[8]     = { 0 };
+
+    Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY | 10s MHz | MAX MHz | THRTL %% |  EVENTS | H/s/GHz |");
+
+    for (size_t i = 0; i < m_cores.size(); ++i) {
+        const Core &core   = m_cores[i];
+        const double mhz   = freq(i, Hashrate::ShortInterval);
+        const double hz    = hashrate ? hashrate->calc(i, Hashrate::ShortInterval) : 0.0;
+
+        if (isCovered(core, Hashrate::ShortInterval)) {
+            snprintf(thr, sizeof thr, "%.1f", throttled(i, Hashrate::ShortInterval));
+        }
+        else {
+            snprintf(thr, sizeof thr, "n/a");
+        }
+
+        Log::print("| %8zu | %8" PRId64 " | %7s | %7s | %7s | %7" PRIu64 " | %7s |",
+                   i,
+                   core.cpu,
+                   Hashrate::format(mhz,               num,         sizeof num / 3),
+                   Hashrate::format(core.max / 1000.0, num + 8,     sizeof num / 3),
+                   thr,
+                   core.throttle[CoreThrottle] - core.throttleStart[CoreThrottle],
+                   Hashrate::format(std::isnormal(mhz) ? hz / (mhz / 1000.0) : 0.0, num + 8 * 2, sizeof num / 3)
+                   );
+    }
+}
+
+
+void xmrig::CoreTelemetry::tick(uint64_t ts)
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_cores.size(); ++i) {
+        Core &core     = m_cores[i];
+        uint64_t value = 0;
+
+        // Frequency is integrated over time (kHz * ms), so the rate over a window is the average frequency.
+        if (!core.freqFile.empty() && readValue(core.freqFile, value)) {
+            if (core.ts) {
+                core.freqTotal += value * (ts - core.ts);
+            }
+
+            core.cur = value;
+            core.ts  = ts;
+
+            m_freq.add(i, core.freqTotal, ts);
+        }
+
+        if (core.thermal) {
+            readValue(core.path + kThrottleCount[CoreThrottle], core.throttle[CoreThrottle]);
+            readValue(core.path + kThrottleCount[PackageThrottle], core.throttle[PackageThrottle]);
+
+            if (readValue(core.path + kThrottleTime, value)) {
+                m_throttled.add(i, value - core.throttleTimeStart, ts);
+
+                if (!core.throttleTs) {
+                    core.throttleTs = ts;
+                }
+            }
+        }
+    }
+}
+
+
+// Zero throttled time is a valid value, so window coverage is checked explicitly instead of relying on NaN.
+bool xmrig::CoreTelemetry::isCovered(const Core &core, size_t ms)
+{
+    return core.throttleTs > 0 && Chrono::steadyMSecs() - core.throttleTs > ms;
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::CoreTelemetry::toJSON(size_t threadId, const Hashrate *hashrate, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (threadId >= m_cores.size() || m_cores[threadId].cpu < 0) {
+        return Value(kNullType);
+    }
+
+    static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+    const Core &core = m_cores[threadId];
+
+    Value out(kObjectType);
+    out.AddMember("cpu", core.cpu, allocator);
+
+    if (!core.freqFile.empty()) {
+        Value mhz(kArrayType);
+        Value efficiency(kArrayType);
+
+        for (size_t ms : intervals) {
+            const double f = freq(threadId, ms);
+
+            mhz.PushBack(Hashrate::normalize(f), allocator);
+            efficiency.PushBack(Hashrate::normalize((hashrate && std::isnormal(f)) ? hashrate->calc(threadId, ms) / (f / 1000.0) : 0.0), allocator);
+        }
+
+        out.AddMember("freq",           mhz, allocator);
+        out.AddMember("freq_cur",       static_cast<uint64_t>(core.cur / 1000), allocator);
+        out.AddMember("freq_max",       core.max ? Value(static_cast<uint64_t>(core.max / 1000)) : Value(kNullType), allocator);
+        out.AddMember("hashes_per_ghz", efficiency, allocator);
+    }
+    else {
+        out.AddMember("freq", kNullType, allocator);
+    }
+
+    if (core.thermal) {
+        Value throttled(kArrayType);
+        for (size_t ms : intervals) {
+            throttled.PushBack(isCovered(core, ms) ? Json::normalize(this->throttled(threadId, ms), true) : Value(kNullType), allocator);
+        }
+
+        Value events(kArrayType);
+        events.PushBack(core.throttle[CoreThrottle] - core.throttleStart[CoreThrottle], allocator);
+        events.PushBack(core.throttle[PackageThrottle] - core.throttleStart[PackageThrottle], allocator);
+
+        out.AddMember("throttled",       throttled, allocator);
+        out.AddMember("throttle_events", events, allocator);
+    }
+    else {
+        out.AddMember("throttled", kNullType, allocator);
+    }
+
+    return out;
+}
+#endif
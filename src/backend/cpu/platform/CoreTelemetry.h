@@ -0,0 +1,95 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CORETELEMETRY_H
+#define XMRIG_CORETELEMETRY_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/common/Hashrate.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+// Samples cpufreq and thermal throttle counters from sysfs for the CPU each worker thread is pinned to,
+// frequency and throttled time are averaged over the same windows as the per-thread hashrate.
+class CoreTelemetry
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(CoreTelemetry)
+
+    enum Throttle : uint32_t {
+        CoreThrottle,
+        PackageThrottle,
+        ThrottleMax
+    };
+
+    static const char *kDefaultRoot;
+
+    CoreTelemetry(const String &root, const std::vector<int64_t> &affinities);
+
+    inline bool isEnabled() const                               { return m_enabled; }
+    inline const String &root() const                           { return m_root; }
+    inline double freq(size_t threadId, size_t ms) const        { return m_freq.calc(threadId, ms) / 1e6; }
+    inline double throttled(size_t threadId, size_t ms) const   { return m_throttled.calc(threadId, ms) / 10.0; }
+
+    void print(const Hashrate *hashrate) const;
+    void tick(uint64_t ts);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(size_t threadId, const Hashrate *hashrate, rapidjson::Document &doc) const;
+#   endif
+
+private:
+    struct Core
+    {
+        int64_t cpu;
+        std::string path;
+        std::string freqFile;
+        bool thermal                            = false;
+        uint64_t cur                            = 0;
+        uint64_t freqTotal                      = 0;
+        uint64_t max                            = 0;
+        uint64_t throttle[ThrottleMax]          = { 0, 0 };
+        uint64_t throttleStart[ThrottleMax]     = { 0, 0 };
+        uint64_t throttleTimeStart              = 0;
+        uint64_t throttleTs                     = 0;
+        uint64_t ts                             = 0;
+    };
+
+    static bool isCovered(const Core &core, size_t ms);
+
+    bool m_enabled = false;
+    const String m_root;
+    Hashrate m_freq;
+    Hashrate m_throttled;
+    std::vector<Core> m_cores;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_CORETELEMETRY_H
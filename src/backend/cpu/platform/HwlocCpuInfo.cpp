@@ -16,14 +16,14 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifdef XMRIG_HWLOC_DEBUG
-#   include <uv.h>
-#endif
-
-
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <hwloc.h>
+#include <thread>
+#include <uv.h>
 
 
 #if HWLOC_API_VERSION < 0x00010b00
@@ -33,7 +33,13 @@
 
 
 #include "backend/cpu/platform/HwlocCpuInfo.h"
+#include "3rdparty/fmt/format.h"
+#include "backend/cpu/platform/Cgroup.h"
+#include "base/crypto/keccak.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Process.h"
+#include "base/kernel/Startup.h"
+#include "base/tools/Cvt.h"
 
 
 namespace xmrig {
@@ -102,12 +108,16 @@ static inline std::vector<hwloc_obj_t> findByType(hwloc_obj_t obj, hwloc_obj_typ
 }
 
 
-static inline size_t countByType(hwloc_obj_t obj, hwloc_obj_type_t type)
+static inline std::vector<hwloc_obj_t> findAllowedPUs(hwloc_obj_t obj)
 {
-    size_t count = 0;
-    findByType(obj, type, [&count](hwloc_obj_t) { count++; });
+    std::vector<hwloc_obj_t> out;
+    findByType(obj, HWLOC_OBJ_PU, [&out](hwloc_obj_t found) {
+        if (Cgroup::isAllowed(found->os_index)) {
+            out.emplace_back(found);
+        }
+    });
 
-    return count;
+    return out;
 }
 
 
@@ -119,13 +129,70 @@ static inline bool isCacheExclusive(hwloc_obj_t obj)
 #endif
 
 
+static bool setThreadMembind(hwloc_topology_t topology, hwloc_const_bitmap_t nodeset, hwloc_membind_policy_t policy)
+{
+    if (!hwloc_topology_get_support(topology)->membind->set_thisthread_membind) {
+        return false;
+    }
+
+#   if HWLOC_API_VERSION >= 0x20000
+    return hwloc_set_membind(topology, nodeset, policy, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET) >= 0;
+#   else
+    return hwloc_set_membind_nodeset(topology, nodeset, policy, HWLOC_MEMBIND_THREAD) >= 0;
+#   endif
+}
+
+
+// Cached topology file name is derived from the machine identity: machine-id (host name as fallback), CPU brand,
+// online CPUs, total memory, allowed cpuset and hwloc API version, any change of them causes a new probe.
+static String topologyCacheFile(const String &dir, const char *brand)
+{
+    std::string id;
+
+#   ifdef XMRIG_OS_LINUX
+    std::ifstream file("/etc/machine-id");
+    std::getline(file, id);
+#   endif
+
+#   if UV_VERSION_HEX >= 0x010c00
+    if (id.empty()) {
+        char hostname[256] = { 0 };
+        size_t size        = sizeof(hostname);
+
+        if (uv_os_gethostname(hostname, &size) == 0) {
+            id.assign(hostname, size);
+        }
+    }
+#   endif
+
+    id += fmt::format("|{}|{}|{}|{}|{:x}", brand, std::thread::hardware_concurrency(), uv_get_total_memory(), Cgroup::cpusetList().isNull() ? "" : Cgroup::cpusetList().data(), HWLOC_API_VERSION);
+
+    uint8_t hash[200];
+    keccak(id.data(), id.size(), hash);
+
+    return fmt::format("{}" XMRIG_DIR_SEPARATOR "hwloc-{}.xml", dir.data(), Cvt::toHex(hash, 8).data()).c_str();
+}
+
+
 } // namespace xmrig
 
 
-xmrig::HwlocCpuInfo::HwlocCpuInfo()
+xmrig::HwlocCpuInfo::HwlocCpuInfo(const String &cacheDir)
 {
-    hwloc_topology_init(&m_topology);
-    hwloc_topology_load(m_topology);
+    const String cacheFile = cacheDir.isEmpty() ? String() : topologyCacheFile(cacheDir, m_brand);
+
+    if (cacheFile.isNull() || !loadTopology(cacheFile)) {
+        hwloc_topology_init(&m_topology);
+        hwloc_topology_load(m_topology);
+
+        if (!cacheFile.isNull()) {
+            Startup::setTopologyCache(Startup::CACHE_MISS);
+            saveTopology(cacheFile);
+        }
+    }
+    else {
+        Startup::setTopologyCache(Startup::CACHE_HIT);
+    }
 
 #   ifdef XMRIG_HWLOC_DEBUG
 #   if defined(UV_VERSION_HEX) && UV_VERSION_HEX >= 0x010c00
@@ -200,17 +267,63 @@ xmrig::HwlocCpuInfo::~HwlocCpuInfo()
 }
 
 
-bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
+bool xmrig::HwlocCpuInfo::loadTopology(const String &fileName)
 {
-    if (!hwloc_topology_get_support(m_topology)->membind->set_thisthread_membind) {
+    if (!std::ifstream(fileName.data()).good()) {
         return false;
     }
 
+    unsigned long flags = HWLOC_TOPOLOGY_FLAG_IS_THISSYSTEM;
+#   if HWLOC_API_VERSION >= 0x20100
+    flags |= HWLOC_TOPOLOGY_FLAG_THISSYSTEM_ALLOWED_RESOURCES;
+#   endif
+
+    hwloc_topology_init(&m_topology);
+
+    if (hwloc_topology_set_xml(m_topology, fileName) == 0 &&
+        hwloc_topology_set_flags(m_topology, flags) == 0 &&
+        hwloc_topology_load(m_topology) == 0 &&
+        hwloc_get_nbobjs_by_type(m_topology, HWLOC_OBJ_PU) > 0)
+    {
+        return true;
+    }
+
+    LOG_WARN("can't load hwloc topology from \"%s\", probing again", fileName.data());
+
+    hwloc_topology_destroy(m_topology);
+    m_topology = nullptr;
+
+    return false;
+}
+
+
+bool xmrig::HwlocCpuInfo::interleave(hwloc_const_bitmap_t nodeset)
+{
+    return setThreadMembind(m_topology, nodeset, HWLOC_MEMBIND_INTERLEAVE);
+}
+
+
+bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
+{
+    return setThreadMembind(m_topology, nodeset, HWLOC_MEMBIND_BIND);
+}
+
+
+void xmrig::HwlocCpuInfo::saveTopology(const String &fileName) const
+{
+    const std::string tmp = fmt::format("{}.tmp", fileName.data());
+
 #   if HWLOC_API_VERSION >= 0x20000
-    return hwloc_set_membind(m_topology, nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET) >= 0;
+    const int rc = hwloc_topology_export_xml(m_topology, tmp.c_str(), 0);
 #   else
-    return hwloc_set_membind_nodeset(m_topology, nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_THREAD) >= 0;
+    const int rc = hwloc_topology_export_xml(m_topology, tmp.c_str());
 #   endif
+
+    if (rc != 0 || rename(tmp.c_str(), fileName) != 0) {
+        remove(tmp.c_str());
+
+        LOG_WARN("can't save hwloc topology to \"%s\"", fileName.data());
+    }
 }
 
 
@@ -231,8 +344,13 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
 
     findCache(hwloc_get_root_obj(m_topology), depth, depth, [&caches](hwloc_obj_t found) { caches.emplace_back(found); });
 
-    if (limit > 0 && limit < 100 && !caches.empty()) {
-        const double maxTotalThreads = round(m_threads * (limit / 100.0));
+    // CFS quota of the container caps the total on top of max-threads-hint, spread over caches the same way.
+    double maxTotalThreads = (limit > 0 && limit < 100) ? round(Cgroup::cpus(m_threads) * (limit / 100.0)) : 0.0;
+    if (Cgroup::maxThreads() && (maxTotalThreads == 0.0 || Cgroup::maxThreads() < maxTotalThreads)) {
+        maxTotalThreads = Cgroup::maxThreads();
+    }
+
+    if (maxTotalThreads > 0.0 && !caches.empty()) {
         const auto maxPerCache       = std::max(static_cast<int>(round(maxTotalThreads / caches.size())), 1);
         int remaining                = std::max(static_cast<int>(maxTotalThreads), 1);
 
@@ -272,7 +390,9 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
     const uint32_t intensity = (algorithm.family() == Algorithm::GHOSTRIDER) ? 8 : 0;
 
     for (const int32_t pu : m_units) {
-        threads.add(pu, intensity);
+        if (Cgroup::isAllowed(pu) && threads.count() < Cgroup::cpus(m_threads)) {
+            threads.add(pu, intensity);
+        }
     }
 
     if (threads.isEmpty()) {
@@ -289,14 +409,18 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 #   ifndef XMRIG_ARM
     constexpr size_t oneMiB = 1024U * 1024U;
 
-    size_t PUs = countByType(cache, HWLOC_OBJ_PU);
+    size_t PUs = findAllowedPUs(cache).size();
     if (PUs == 0) {
         return;
     }
 
     std::vector<hwloc_obj_t> cores;
     cores.reserve(m_cores);
-    findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) { cores.emplace_back(found); });
+    findByType(cache, HWLOC_OBJ_CORE, [&cores](hwloc_obj_t found) {
+        if (!findAllowedPUs(found).empty()) {
+            cores.emplace_back(found);
+        }
+    });
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if ((algorithm == Algorithm::GHOSTRIDER_RTM) && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
@@ -369,7 +493,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 
     if (cacheHashes >= PUs) {
         for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            const std::vector<hwloc_obj_t> units = findAllowedPUs(core);
             for (hwloc_obj_t pu : units) {
                 threads.add(pu->os_index, intensity);
             }
@@ -387,7 +511,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 
         threads_data.clear();
         for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            const std::vector<hwloc_obj_t> units = findAllowedPUs(core);
             if (units.size() <= pu_id) {
                 continue;
             }
@@ -22,6 +22,7 @@
 
 #include "backend/cpu/platform/BasicCpuInfo.h"
 #include "base/tools/Object.h"
+#include "base/tools/String.h"
 
 
 using hwloc_const_bitmap_t  = const struct hwloc_bitmap_s *;
@@ -43,7 +44,7 @@ public:
     };
 
 
-    HwlocCpuInfo();
+    explicit HwlocCpuInfo(const String &cacheDir);
     ~HwlocCpuInfo() override;
 
     static inline bool hasFeature(Feature feature)              { return m_features & feature; }
@@ -51,6 +52,7 @@ public:
     inline const std::vector<uint32_t> &nodeset() const         { return m_nodeset; }
     inline hwloc_topology_t topology() const                    { return m_topology; }
 
+    bool interleave(hwloc_const_bitmap_t nodeset);
     bool membind(hwloc_const_bitmap_t nodeset);
 
 protected:
@@ -64,8 +66,10 @@ protected:
     inline size_t packages() const override         { return m_packages; }
 
 private:
+    bool loadTopology(const String &fileName);
     CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit) const;
     void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const;
+    void saveTopology(const String &fileName) const;
     void setThreads(size_t threads);
 
     static uint32_t m_features;
@@ -38,6 +38,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesInfo.h"
 
 
 #ifdef XMRIG_ALGO_KAWPOW
@@ -339,6 +340,12 @@ const xmrig::Hashrate *xmrig::CudaBackend::hashrate() const
 }
 
 
+xmrig::HugePagesInfo xmrig::CudaBackend::hugePages() const
+{
+    return {};
+}
+
+
 const xmrig::String &xmrig::CudaBackend::profileName() const
 {
     return d_ptr->profileName;
@@ -361,6 +368,12 @@ void xmrig::CudaBackend::prepare(const Job &job)
     if (d_ptr) {
         d_ptr->workers.jobEarlyNotification(job);
     }
+
+#   ifdef XMRIG_ALGO_KAWPOW
+    if (job.algorithm().family() == Algorithm::KAWPOW && isEnabled()) {
+        KPCache::prepare(job.height() / KPHash::EPOCH_LENGTH);
+    }
+#   endif
 }
 
 
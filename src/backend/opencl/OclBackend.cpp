@@ -39,6 +39,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesInfo.h"
 
 
 #ifdef XMRIG_ALGO_KAWPOW
@@ -319,6 +320,12 @@ const xmrig::Hashrate *xmrig::OclBackend::hashrate() const
 }
 
 
+xmrig::HugePagesInfo xmrig::OclBackend::hugePages() const
+{
+    return {};
+}
+
+
 const xmrig::String &xmrig::OclBackend::profileName() const
 {
     return d_ptr->profileName;
@@ -341,6 +348,12 @@ void xmrig::OclBackend::prepare(const Job &job)
     if (d_ptr) {
         d_ptr->workers.jobEarlyNotification(job);
     }
+
+#   ifdef XMRIG_ALGO_KAWPOW
+    if (job.algorithm().family() == Algorithm::KAWPOW && isEnabled()) {
+        KPCache::prepare(job.height() / KPHash::EPOCH_LENGTH);
+    }
+#   endif
 }
 
 
@@ -48,6 +48,7 @@ protected:
     bool isEnabled() const override;
     bool isEnabled(const Algorithm &algorithm) const override;
     const Hashrate *hashrate() const override;
+    HugePagesInfo hugePages() const override;
     const String &profileName() const override;
     const String &type() const override;
     void execCommand(char command) override;
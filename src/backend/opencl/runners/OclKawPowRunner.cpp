@@ -130,19 +130,20 @@ void OclKawPowRunner::set(const Job &job, uint8_t *blob)
         m_epoch = epoch;
 
         {
-            std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-
-            KPCache::s_cache.init(epoch);
+            const auto cache = KPCache::get(epoch);
+            if (!cache) {
+                throw std::runtime_error("invalid KawPow epoch");
+            }
 
-            if (KPCache::s_cache.size() > m_lightCacheCapacity) {
+            if (cache->size() > m_lightCacheCapacity) {
                 OclLib::release(m_lightCache);
 
-                m_lightCacheCapacity = VirtualMemory::align(KPCache::s_cache.size());
+                m_lightCacheCapacity = VirtualMemory::align(cache->size());
                 m_lightCache = OclLib::createBuffer(m_ctx, CL_MEM_READ_ONLY, m_lightCacheCapacity);
             }
 
-            m_lightCacheSize = KPCache::s_cache.size();
-            enqueueWriteBuffer(m_lightCache, CL_TRUE, 0, m_lightCacheSize, KPCache::s_cache.data());
+            m_lightCacheSize = cache->size();
+            enqueueWriteBuffer(m_lightCache, CL_TRUE, 0, m_lightCacheSize, cache->data());
         }
 
         const uint64_t start_ms = Chrono::steadyMSecs();
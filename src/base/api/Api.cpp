@@ -20,12 +20,19 @@
 
 
 #include "base/api/Api.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
 #include "base/io/Env.h"
 #include "base/io/json/Json.h"
+#include "base/io/log/FileLogWriter.h"
 #include "base/kernel/Base.h"
+#include "base/kernel/Startup.h"
+#include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpData.h"
+#include "base/net/http/HttpResponse.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -75,6 +82,19 @@ static rapidjson::Value getResources(rapidjson::Document &doc)
 }
 
 
+static rapidjson::Value getLog(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("dropped",      FileLogWriter::dropped(), allocator);
+    out.AddMember("write_errors", FileLogWriter::errors(), allocator);
+
+    return out;
+}
+
+
 } // namespace xmrig
 
 
@@ -96,6 +116,49 @@ xmrig::Api::~Api()
 }
 
 
+bool xmrig::Api::subscribe(const HttpData &req)
+{
+    return m_events.subscribe(req);
+}
+
+
+void xmrig::Api::metrics(const HttpData &req)
+{
+    m_metrics.clear();
+
+    m_metrics.add("xmrig_info", MetricsWriter::GAUGE, "Miner identity.");
+    m_metrics.sample("xmrig_info", { { "id", m_id }, { "worker_id", m_workerId.data() }, { "version", APP_VERSION }, { "kind", APP_KIND } }, static_cast<uint64_t>(1));
+
+    m_metrics.add("xmrig_uptime_seconds", MetricsWriter::GAUGE, "Time since the miner started.");
+    m_metrics.sample("xmrig_uptime_seconds", (Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000.0);
+
+    for (IApiListener *listener : m_listeners) {
+        listener->onMetrics(m_metrics);
+    }
+
+    HttpResponse response(req.id());
+    response.setHeader(HttpData::kContentType, MetricsWriter::kContentType);
+    response.end(m_metrics.data().data(), m_metrics.data().size());
+}
+
+
+void xmrig::Api::publish(const char *event, const rapidjson::Value &value)
+{
+    using namespace rapidjson;
+
+    if (m_events.isEmpty()) {
+        return;
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(10);
+    value.Accept(writer);
+
+    m_events.publish(event, buffer.GetString(), buffer.GetSize());
+}
+
+
 void xmrig::Api::request(const HttpData &req)
 {
     HttpApiRequest request(req, m_base->config()->http().isRestricted());
@@ -104,6 +167,18 @@ void xmrig::Api::request(const HttpData &req)
 }
 
 
+void xmrig::Api::verify(const HttpData &req)
+{
+    for (IApiListener *listener : m_listeners) {
+        if (listener->onVerify(req)) {
+            return;
+        }
+    }
+
+    HttpApiResponse(req.id(), 404 /* NOT_FOUND */).end();
+}
+
+
 void xmrig::Api::start()
 {
     genWorkerId(m_base->config()->apiWorkerId());
@@ -118,7 +193,9 @@ void xmrig::Api::start()
 void xmrig::Api::stop()
 {
 #   ifdef XMRIG_FEATURE_HTTP
-    m_httpd->stop();
+    if (m_httpd) {
+        m_httpd->stop();
+    }
 #   endif
 }
 
@@ -150,6 +227,8 @@ void xmrig::Api::exec(IApiRequest &request)
         reply.AddMember("uptime",     (Chrono::currentMSecsSinceEpoch() - m_timestamp) / 1000, allocator);
         reply.AddMember("restricted", request.isRestricted(), allocator);
         reply.AddMember("resources",  getResources(request.doc()), allocator);
+        reply.AddMember("startup",    Startup::toJSON(request.doc()), allocator);
+        reply.AddMember("log",        getLog(request.doc()), allocator);
 
         Value features(kArrayType);
 #       ifdef XMRIG_FEATURE_API
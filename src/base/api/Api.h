@@ -24,7 +24,10 @@
 #include <cstdint>
 
 
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/api/MetricsWriter.h"
 #include "base/kernel/interfaces/IBaseListener.h"
+#include "base/net/http/HttpEventStream.h"
 #include "base/tools/String.h"
 
 
@@ -47,11 +50,16 @@ public:
     Api(Base *base);
     ~Api() override;
 
+    inline bool isStreaming() const                 { return !m_events.isEmpty(); }
     inline const char *id() const                   { return m_id; }
     inline const char *workerId() const             { return m_workerId; }
     inline void addListener(IApiListener *listener) { m_listeners.push_back(listener); }
 
+    bool subscribe(const HttpData &req);
+    void metrics(const HttpData &req);
+    void publish(const char *event, const rapidjson::Value &value);
     void request(const HttpData &req);
+    void verify(const HttpData &req);
     void start();
     void stop();
 
@@ -68,6 +76,8 @@ private:
     String m_workerId;
     const uint64_t m_timestamp;
     Httpd *m_httpd = nullptr;
+    HttpEventStream m_events;
+    MetricsWriter m_metrics;
     std::vector<IApiListener *> m_listeners;
 };
 
@@ -37,6 +37,9 @@
 namespace xmrig {
 
 static const char *kAuthorization = "authorization";
+static const char *kEvents        = "/2/events";
+static const char *kMetrics       = "/metrics";
+static const char *kVerify        = "/2/verify";
 
 #ifdef _WIN32
 static const char *favicon = nullptr;
@@ -161,6 +164,18 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
         return HttpApiResponse(data.id(), status).end();
     }
 
+    if (data.method == HTTP_GET && data.url == kEvents) {
+        if (!m_base->api()->subscribe(data)) {
+            return HttpApiResponse(data.id(), 503 /* SERVICE_UNAVAILABLE */).end();
+        }
+
+        return;
+    }
+
+    if (data.method == HTTP_GET && data.url == kMetrics) {
+        return m_base->api()->metrics(data);
+    }
+
     if (data.method != HTTP_GET) {
         if (m_base->config()->http().isRestricted()) {
             return HttpApiResponse(data.id(), 403 /* FORBIDDEN */).end();
@@ -171,6 +186,11 @@ void xmrig::Httpd::onHttpData(const HttpData &data)
         }
     }
 
+    // Hash verification can keep all verifier threads busy, so like other POST requests it requires unrestricted mode.
+    if (data.method == HTTP_POST && data.url == kVerify) {
+        return m_base->api()->verify(data);
+    }
+
     m_base->api()->request(data);
 }
 
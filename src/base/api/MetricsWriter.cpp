@@ -0,0 +1,113 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/api/MetricsWriter.h"
+
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+const char *MetricsWriter::kContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+
+static const char *typeNames[] = { "counter", "gauge" };
+
+
+} // namespace xmrig
+
+
+void xmrig::MetricsWriter::add(const char *name, Type type, const char *help)
+{
+    m_data.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    m_data.append("# TYPE ").append(name).append(" ").append(typeNames[type]).append("\n");
+}
+
+
+void xmrig::MetricsWriter::sample(const char *name, const Labels &labels, double value)
+{
+    // Checked by bits, the build uses -ffast-math where std::isfinite() may be folded away.
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    if ((bits & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL) {
+        return;
+    }
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), " %.10g\n", value);
+
+    m_data.append(name);
+    this->labels(labels);
+    m_data.append(buf);
+}
+
+
+void xmrig::MetricsWriter::sample(const char *name, const Labels &labels, uint64_t value)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), " %" PRIu64 "\n", value);
+
+    m_data.append(name);
+    this->labels(labels);
+    m_data.append(buf);
+}
+
+
+void xmrig::MetricsWriter::labels(const Labels &labels)
+{
+    if (labels.size() == 0) {
+        return;
+    }
+
+    char sep = '{';
+
+    for (const auto &label : labels) {
+        m_data.push_back(sep);
+        m_data.append(label.first).append("=\"");
+
+        for (const char *c = label.second ? label.second : ""; *c; ++c) {
+            switch (*c) {
+            case '\\':
+                m_data.append("\\\\");
+                break;
+
+            case '"':
+                m_data.append("\\\"");
+                break;
+
+            case '\n':
+                m_data.append("\\n");
+                break;
+
+            default:
+                m_data.push_back(*c);
+                break;
+            }
+        }
+
+        m_data.push_back('"');
+        sep = ',';
+    }
+
+    m_data.push_back('}');
+}
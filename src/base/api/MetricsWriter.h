@@ -0,0 +1,77 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_METRICSWRITER_H
+#define XMRIG_METRICSWRITER_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+
+namespace xmrig {
+
+
+/**
+ * Renders metrics in the Prometheus text exposition format (version 0.0.4).
+ *
+ * Output goes straight into an internal string, clear() keeps its capacity so
+ * a writer owned by the API allocates only on the first few scrapes.
+ */
+class MetricsWriter
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(MetricsWriter)
+
+    enum Type {
+        COUNTER,
+        GAUGE
+    };
+
+    using Labels = std::initializer_list<std::pair<const char *, const char *> >;
+
+    static const char *kContentType;
+
+    MetricsWriter() = default;
+
+    inline const std::string &data() const  { return m_data; }
+    inline void clear()                     { m_data.clear(); }
+
+    void add(const char *name, Type type, const char *help);
+    void sample(const char *name, const Labels &labels, double value);
+    void sample(const char *name, const Labels &labels, uint64_t value);
+
+    inline void sample(const char *name, double value)      { sample(name, {}, value); }
+    inline void sample(const char *name, uint64_t value)    { sample(name, {}, value); }
+
+private:
+    void labels(const Labels &labels);
+
+    std::string m_data;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_METRICSWRITER_H */
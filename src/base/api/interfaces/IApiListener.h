@@ -26,7 +26,9 @@
 namespace xmrig {
 
 
+class HttpData;
 class IApiRequest;
+class MetricsWriter;
 
 
 class IApiListener
@@ -38,6 +40,8 @@ public:
     virtual ~IApiListener() = default;
 
 #   ifdef XMRIG_FEATURE_API
+    virtual bool onVerify(const HttpData &) { return false; }
+    virtual void onMetrics(MetricsWriter &) {}
     virtual void onRequest(IApiRequest &request) = 0;
 #   endif
 };
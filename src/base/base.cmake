@@ -43,6 +43,7 @@ set(HEADERS_BASE
     src/base/kernel/interfaces/IWatcherListener.h
     src/base/kernel/Platform.h
     src/base/kernel/Process.h
+    src/base/kernel/Startup.h
     src/base/net/dns/Dns.h
     src/base/net/dns/DnsConfig.h
     src/base/net/dns/DnsRecord.h
@@ -53,6 +54,7 @@ set(HEADERS_BASE
     src/base/net/http/HttpListener.h
     src/base/net/stratum/BaseClient.h
     src/base/net/stratum/Client.h
+    src/base/net/stratum/Connector.h
     src/base/net/stratum/Job.h
     src/base/net/stratum/NetworkState.h
     src/base/net/stratum/Pool.h
@@ -60,6 +62,7 @@ set(HEADERS_BASE
     src/base/net/stratum/ProxyUrl.h
     src/base/net/stratum/Socks5.h
     src/base/net/stratum/strategies/FailoverStrategy.h
+    src/base/net/stratum/strategies/LatencyStrategy.h
     src/base/net/stratum/strategies/SinglePoolStrategy.h
     src/base/net/stratum/strategies/StrategyProxy.h
     src/base/net/stratum/SubmitResult.h
@@ -113,6 +116,7 @@ set(SOURCES_BASE
     src/base/kernel/Entry.cpp
     src/base/kernel/Platform.cpp
     src/base/kernel/Process.cpp
+    src/base/kernel/Startup.cpp
     src/base/net/dns/Dns.cpp
     src/base/net/dns/DnsConfig.cpp
     src/base/net/dns/DnsRecord.cpp
@@ -121,6 +125,7 @@ set(SOURCES_BASE
     src/base/net/http/Http.cpp
     src/base/net/stratum/BaseClient.cpp
     src/base/net/stratum/Client.cpp
+    src/base/net/stratum/Connector.cpp
     src/base/net/stratum/Job.cpp
     src/base/net/stratum/NetworkState.cpp
     src/base/net/stratum/Pool.cpp
@@ -128,6 +133,7 @@ set(SOURCES_BASE
     src/base/net/stratum/ProxyUrl.cpp
     src/base/net/stratum/Socks5.cpp
     src/base/net/stratum/strategies/FailoverStrategy.cpp
+    src/base/net/stratum/strategies/LatencyStrategy.cpp
     src/base/net/stratum/strategies/SinglePoolStrategy.cpp
     src/base/net/stratum/Url.cpp
     src/base/net/tools/LineReader.cpp
@@ -187,6 +193,7 @@ if (WITH_HTTP)
         src/3rdparty/llhttp/llhttp.h
         src/base/api/Api.h
         src/base/api/Httpd.h
+        src/base/api/MetricsWriter.h
         src/base/api/interfaces/IApiRequest.h
         src/base/api/requests/ApiRequest.h
         src/base/api/requests/HttpApiRequest.h
@@ -198,6 +205,7 @@ if (WITH_HTTP)
         src/base/net/http/HttpClient.h
         src/base/net/http/HttpContext.h
         src/base/net/http/HttpData.h
+        src/base/net/http/HttpEventStream.h
         src/base/net/http/HttpResponse.h
         src/base/net/stratum/DaemonClient.h
         src/base/net/stratum/SelfSelectClient.h
@@ -210,6 +218,7 @@ if (WITH_HTTP)
         src/3rdparty/llhttp/http.c
         src/base/api/Api.cpp
         src/base/api/Httpd.cpp
+        src/base/api/MetricsWriter.cpp
         src/base/api/requests/ApiRequest.cpp
         src/base/api/requests/HttpApiRequest.cpp
         src/base/net/http/Fetch.cpp
@@ -217,6 +226,7 @@ if (WITH_HTTP)
         src/base/net/http/HttpClient.cpp
         src/base/net/http/HttpContext.cpp
         src/base/net/http/HttpData.cpp
+        src/base/net/http/HttpEventStream.cpp
         src/base/net/http/HttpListener.cpp
         src/base/net/http/HttpResponse.cpp
         src/base/net/stratum/DaemonClient.cpp
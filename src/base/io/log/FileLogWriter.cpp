@@ -18,89 +18,444 @@
 
 
 #include "base/io/log/FileLogWriter.h"
+#include "base/io/Async.h"
 #include "base/io/Env.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/String.h"
+#include "base/tools/Timer.h"
 
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
 #include <uv.h>
 
 
 namespace xmrig {
 
 
-static void fsWriteCallback(uv_fs_t *req)
+#ifdef XMRIG_OS_WIN
+static const char kEndl[]   = "\r\n";
+#else
+static const char kEndl[]   = "\n";
+#endif
+
+
+// Process-wide totals, a failed or short write loses the lines it carried.
+static std::atomic<uint64_t> droppedLines{ 0 };
+static std::atomic<uint64_t> writeErrors{ 0 };
+
+
+class FileLogWriterPrivate : public ITimerListener
 {
-    delete [] static_cast<char *>(req->data);
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(FileLogWriterPrivate)
+
+    FileLogWriterPrivate(uint64_t maxSize) :
+        m_buf(new char[FileLogWriter::kBufferSize]),
+        m_maxSize(maxSize)
+    {
+        m_req.data = this;
+        m_async    = new Async([this]{ write(); });
+        m_timer    = new Timer(this, FileLogWriter::kFlushInterval, FileLogWriter::kFlushInterval);
+    }
+
+
+    ~FileLogWriterPrivate() override
+    {
+        close();
+
+        delete [] m_buf;
+    }
 
-    uv_fs_req_cleanup(req);
-    delete req;
-}
+
+    bool open(const char *fileName, bool truncate = false);
+    bool append(const char *data, size_t size, const char *endl = nullptr, size_t endlSize = 0);
+    void flush();
+    void release();
+    void write();
+
+    int file            = -1;
+    int64_t pos         = 0;
+    std::mutex mutex;
+
+protected:
+    inline void onTimer(const Timer *) override { write(); }
+
+private:
+    inline size_t used() const  { return static_cast<size_t>(m_head - m_tail); }
+
+    static void onWrite(uv_fs_t *req);
+
+    bool push(const char *data, size_t size);
+    size_t pending(uv_buf_t *bufs, uint64_t from) const;
+    void close();
+    void rotate();
+
+    Async *m_async      = nullptr;
+    bool m_orphan       = false;
+    bool m_scheduled    = false;
+    char *m_buf;
+    const uint64_t m_maxSize;
+    String m_path;
+    Timer *m_timer      = nullptr;
+    uint64_t m_head     = 0;
+    uint64_t m_lost     = 0;
+    uint64_t m_synced   = 0;
+    uint64_t m_tail     = 0;
+    uint64_t m_writing  = 0;
+    uv_fs_t m_req{};
+};
 
 
 } // namespace xmrig
 
 
-bool xmrig::FileLogWriter::open(const char *fileName)
+bool xmrig::FileLogWriterPrivate::open(const char *fileName, bool truncate)
 {
-    assert(fileName != nullptr);
-    if (!fileName) {
-        return false;
-    }
+    close();
 
     uv_fs_t req{};
-    const auto path = Env::expand(fileName);
-    m_file          = uv_fs_open(uv_default_loop(), &req, path, O_CREAT | O_WRONLY, 0644, nullptr);
+    m_path = Env::expand(fileName);
+    file   = uv_fs_open(uv_default_loop(), &req, m_path, O_CREAT | O_WRONLY | (truncate ? O_TRUNC : 0), 0644, nullptr);
 
-    if (req.result < 0 || !isOpen()) {
+    if (req.result < 0 || file < 0) {
         uv_fs_req_cleanup(&req);
-        m_file = -1;
+        file = -1;
 
         return false;
     }
 
     uv_fs_req_cleanup(&req);
 
-    uv_fs_stat(uv_default_loop(), &req, path, nullptr);
-    m_pos = req.statbuf.st_size;
+    uv_fs_stat(uv_default_loop(), &req, m_path, nullptr);
+    pos = req.statbuf.st_size;
     uv_fs_req_cleanup(&req);
 
     return true;
 }
 
 
-bool xmrig::FileLogWriter::write(const char *data, size_t size)
+bool xmrig::FileLogWriterPrivate::append(const char *data, size_t size, const char *endl, size_t endlSize)
 {
-    if (!isOpen()) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file < 0) {
         return false;
     }
 
-    uv_buf_t buf = uv_buf_init(new char[size], size);
-    memcpy(buf.base, data, size);
+    if (m_lost) {
+        char note[64];
+        const int rc = snprintf(note, sizeof(note), "*** %" PRIu64 " log lines dropped ***%s", m_lost, kEndl);
 
-    auto req = new uv_fs_t;
-    req->data = buf.base;
+        if (rc > 0 && push(note, static_cast<size_t>(rc))) {
+            m_lost = 0;
+        }
+    }
+
+    if (used() + size + endlSize > FileLogWriter::kBufferSize || m_lost) {
+        ++m_lost;
+        ++droppedLines;
 
-    uv_fs_write(uv_default_loop(), req, m_file, &buf, 1, m_pos, fsWriteCallback);
-    m_pos += size;
+        return false;
+    }
+
+    push(data, size);
+    if (endlSize) {
+        push(endl, endlSize);
+    }
+
+    if (used() >= FileLogWriter::kFlushThreshold && !m_scheduled) {
+        m_scheduled = true;
+        m_async->send();
+    }
 
     return true;
 }
 
 
-bool xmrig::FileLogWriter::writeLine(const char *data, size_t size)
+void xmrig::FileLogWriterPrivate::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file < 0) {
+        return;
+    }
+
+    // A write already in flight owns the head of the ring, so append everything after it.
+    const uint64_t from = m_tail + m_writing + m_synced;
+    if (from == m_head) {
+        return;
+    }
+
+    if (!m_writing && m_maxSize && static_cast<uint64_t>(pos) >= m_maxSize) {
+        rotate();
+
+        if (file < 0) {
+            return;
+        }
+    }
+
+    uv_buf_t bufs[2];
+    const size_t count = pending(bufs, from);
+    const auto size    = m_head - from;
+
+    uv_fs_t req{};
+    uv_fs_write(uv_default_loop(), &req, file, bufs, count, pos, nullptr);
+
+    if (req.result < 0 || static_cast<uint64_t>(req.result) < size) {
+        ++writeErrors;
+    }
+
+    uv_fs_req_cleanup(&req);
+
+    pos += size;
+
+    if (m_writing) {
+        m_synced += size;
+    }
+    else {
+        m_tail = m_head;
+    }
+}
+
+
+void xmrig::FileLogWriterPrivate::release()
 {
-    const uv_buf_t buf[2] = {
-        uv_buf_init(new char[size], size),
-        uv_buf_init(const_cast<char *>(m_endl), sizeof(m_endl) - 1)
-    };
+    delete m_timer;
+    delete m_async;
 
-    memcpy(buf[0].base, data, size);
+    m_timer = nullptr;
+    m_async = nullptr;
 
-    auto req = new uv_fs_t;
-    req->data = buf[0].base;
+    flush();
 
-    uv_fs_write(uv_default_loop(), req, m_file, buf, 2, m_pos, fsWriteCallback);
-    m_pos += (buf[0].len + buf[1].len);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (m_writing) {
+            m_orphan = true;
+
+            return;
+        }
+    }
+
+    delete this;
+}
+
+
+void xmrig::FileLogWriterPrivate::write()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    m_scheduled = false;
+
+    if (file < 0 || m_writing || m_head == m_tail) {
+        return;
+    }
+
+    if (m_maxSize && static_cast<uint64_t>(pos) >= m_maxSize) {
+        rotate();
+
+        if (file < 0) {
+            return;
+        }
+    }
+
+    uv_buf_t bufs[2];
+    const size_t count = pending(bufs, m_tail);
+    m_writing          = m_head - m_tail;
+
+    uv_fs_write(uv_default_loop(), &m_req, file, bufs, count, pos, onWrite);
+    pos += m_writing;
+}
+
+
+void xmrig::FileLogWriterPrivate::onWrite(uv_fs_t *req)
+{
+    auto d             = static_cast<FileLogWriterPrivate *>(req->data);
+    const auto result  = req->result;
+    uv_fs_req_cleanup(req);
+
+    bool orphan = false;
+    bool next   = false;
+
+    {
+        std::lock_guard<std::mutex> lock(d->mutex);
+
+        if (result < 0 || static_cast<uint64_t>(result) < d->m_writing) {
+            ++writeErrors;
+        }
+
+        d->m_tail    += d->m_writing + d->m_synced;
+        d->m_writing  = 0;
+        d->m_synced   = 0;
+        orphan        = d->m_orphan;
+        next          = !orphan && d->used() >= FileLogWriter::kFlushThreshold;
+    }
+
+    if (orphan) {
+        delete d;
+    }
+    else if (next) {
+        d->write();
+    }
+}
+
+
+bool xmrig::FileLogWriterPrivate::push(const char *data, size_t size)
+{
+    if (used() + size > FileLogWriter::kBufferSize) {
+        return false;
+    }
+
+    const size_t offset = m_head % FileLogWriter::kBufferSize;
+    const size_t first  = std::min(size, FileLogWriter::kBufferSize - offset);
+
+    memcpy(m_buf + offset, data, first);
+    if (size > first) {
+        memcpy(m_buf, data + first, size - first);
+    }
+
+    m_head += size;
 
     return true;
 }
+
+
+size_t xmrig::FileLogWriterPrivate::pending(uv_buf_t *bufs, uint64_t from) const
+{
+    const size_t size   = static_cast<size_t>(m_head - from);
+    const size_t offset = from % FileLogWriter::kBufferSize;
+    const size_t first  = std::min(size, FileLogWriter::kBufferSize - offset);
+
+    bufs[0] = uv_buf_init(m_buf + offset, static_cast<unsigned int>(first));
+    if (size == first) {
+        return 1;
+    }
+
+    bufs[1] = uv_buf_init(m_buf, static_cast<unsigned int>(size - first));
+
+    return 2;
+}
+
+
+void xmrig::FileLogWriterPrivate::close()
+{
+    if (file < 0) {
+        return;
+    }
+
+    uv_fs_t req{};
+    uv_fs_close(uv_default_loop(), &req, file, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    file = -1;
+}
+
+
+void xmrig::FileLogWriterPrivate::rotate()
+{
+    close();
+
+    char from[512];
+    char to[512];
+    uv_fs_t req{};
+
+    for (int i = FileLogWriter::kRotateFiles; i > 0; --i) {
+        if (i > 1) {
+            snprintf(from, sizeof(from), "%s.%d", m_path.data(), i - 1);
+        }
+        else {
+            snprintf(from, sizeof(from), "%s", m_path.data());
+        }
+
+        snprintf(to, sizeof(to), "%s.%d", m_path.data(), i);
+
+        uv_fs_rename(uv_default_loop(), &req, from, to, nullptr);
+        uv_fs_req_cleanup(&req);
+    }
+
+    const String path = m_path;
+    open(path, true);
+}
+
+
+xmrig::FileLogWriter::FileLogWriter() :
+    d_ptr(new FileLogWriterPrivate(0))
+{
+}
+
+
+xmrig::FileLogWriter::FileLogWriter(const char *fileName, uint64_t maxSize) :
+    d_ptr(new FileLogWriterPrivate(maxSize))
+{
+    open(fileName);
+}
+
+
+xmrig::FileLogWriter::~FileLogWriter()
+{
+    d_ptr->release();
+}
+
+
+bool xmrig::FileLogWriter::isOpen() const
+{
+    return d_ptr->file >= 0;
+}
+
+
+int64_t xmrig::FileLogWriter::pos() const
+{
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    return d_ptr->pos;
+}
+
+
+uint64_t xmrig::FileLogWriter::dropped()
+{
+    return droppedLines.load(std::memory_order_relaxed);
+}
+
+
+uint64_t xmrig::FileLogWriter::errors()
+{
+    return writeErrors.load(std::memory_order_relaxed);
+}
+
+
+bool xmrig::FileLogWriter::open(const char *fileName)
+{
+    assert(fileName != nullptr);
+    if (!fileName) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(d_ptr->mutex);
+
+    return d_ptr->open(fileName);
+}
+
+
+bool xmrig::FileLogWriter::write(const char *data, size_t size)
+{
+    return d_ptr->append(data, size);
+}
+
+
+bool xmrig::FileLogWriter::writeLine(const char *data, size_t size)
+{
+    return d_ptr->append(data, size, kEndl, sizeof(kEndl) - 1);
+}
+
+
+void xmrig::FileLogWriter::flush()
+{
+    d_ptr->flush();
+}
@@ -20,6 +20,9 @@
 #define XMRIG_FILELOGWRITER_H
 
 
+#include "base/tools/Object.h"
+
+
 #include <cstddef>
 #include <cstdint>
 
@@ -27,28 +30,36 @@
 namespace xmrig {
 
 
+class FileLogWriterPrivate;
+
+
 class FileLogWriter
 {
 public:
-    FileLogWriter() = default;
-    FileLogWriter(const char *fileName) { open(fileName); }
+    XMRIG_DISABLE_COPY_MOVE(FileLogWriter)
 
-    inline bool isOpen() const  { return m_file >= 0; }
-    inline int64_t pos() const  { return m_pos; }
+    constexpr static size_t kBufferSize         = 512 * 1024;
+    constexpr static size_t kFlushThreshold     = 64 * 1024;
+    constexpr static uint64_t kFlushInterval    = 500;
+    constexpr static int kRotateFiles           = 3;
+
+    FileLogWriter();
+    FileLogWriter(const char *fileName, uint64_t maxSize = 0);
+    ~FileLogWriter();
+
+    bool isOpen() const;
+    int64_t pos() const;
 
     bool open(const char *fileName);
     bool write(const char *data, size_t size);
     bool writeLine(const char *data, size_t size);
+    void flush();
+
+    static uint64_t dropped();
+    static uint64_t errors();
 
 private:
-#   ifdef XMRIG_OS_WIN
-    const char m_endl[3]  = {'\r', '\n', 0};
-#   else
-    const char m_endl[2]  = {'\n', 0};
-#   endif
-
-    int m_file      = -1;
-    int64_t m_pos   = 0;
+    FileLogWriterPrivate *d_ptr;
 };
 
 
@@ -79,6 +79,16 @@ public:
     inline void add(ILogBackend *backend) { m_backends.push_back(backend); }
 
 
+    inline void flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto backend : m_backends) {
+            backend->flush();
+        }
+    }
+
+
     void print(Log::Level level, const char *fmt, va_list args)
     {
         size_t size   = 0;
@@ -219,6 +229,14 @@ void xmrig::Log::destroy()
 }
 
 
+void xmrig::Log::flush()
+{
+    if (d) {
+        d->flush();
+    }
+}
+
+
 void xmrig::Log::init()
 {
     d = new LogPrivate();
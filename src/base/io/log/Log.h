@@ -51,6 +51,7 @@ public:
 
     static void add(ILogBackend *backend);
     static void destroy();
+    static void flush();
     static void init();
     static void print(const char *fmt, ...);
     static void print(Level level, const char *fmt, ...);
@@ -25,12 +25,18 @@
 #include <cstring>
 
 
-xmrig::FileLog::FileLog(const char *fileName) :
-    m_writer(fileName)
+xmrig::FileLog::FileLog(const char *fileName, uint64_t maxSize) :
+    m_writer(fileName, maxSize)
 {
 }
 
 
+void xmrig::FileLog::flush()
+{
+    m_writer.flush();
+}
+
+
 void xmrig::FileLog::print(uint64_t, int, const char *line, size_t, size_t size, bool colors)
 {
     if (!m_writer.isOpen() || colors) {
@@ -31,9 +31,10 @@ namespace xmrig {
 class FileLog : public ILogBackend
 {
 public:
-    FileLog(const char *fileName);
+    FileLog(const char *fileName, uint64_t maxSize = 0);
 
 protected:
+    void flush() override;
     void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) override;
 
 private:
@@ -31,7 +31,10 @@
 #include "base/kernel/interfaces/IBaseListener.h"
 #include "base/kernel/Platform.h"
 #include "base/kernel/Process.h"
+#include "base/kernel/Startup.h"
+#include "base/net/stratum/Client.h"
 #include "base/net/tools/NetBuffer.h"
+#include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/config/ConfigTransform.h"
 #include "version.h"
@@ -73,7 +76,9 @@ public:
     {
         Log::init();
 
+        const uint64_t ts = Chrono::steadyMSecs();
         config = load(process);
+        Startup::set(Startup::CONFIG, Chrono::steadyMSecs() - ts);
     }
 
 
@@ -87,6 +92,10 @@ public:
         delete watcher;
 
         NetBuffer::destroy();
+
+#       ifdef XMRIG_FEATURE_TLS
+        Client::releaseTls();
+#       endif
     }
 
 
@@ -197,7 +206,7 @@ int xmrig::Base::init()
     }
 
     if (config()->logFile()) {
-        Log::add(new FileLog(config()->logFile()));
+        Log::add(new FileLog(config()->logFile(), static_cast<uint64_t>(config()->logFileSize()) * 1024 * 1024));
     }
 
 #   ifdef HAVE_SYSLOG_H
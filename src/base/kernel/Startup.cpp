@@ -0,0 +1,180 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/kernel/Startup.h"
+#include "3rdparty/fmt/format.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+
+
+#include <atomic>
+#include <string>
+
+
+namespace xmrig {
+
+
+static const char *kPhaseNames[Startup::PHASE_MAX] = {
+    "config",
+    "topology",
+    "dmi",
+    "huge_pages",
+    "self_test",
+    "threads",
+    "dataset_alloc",
+    "dataset_init"
+};
+
+
+static const char *kCacheNames[] = {
+    "off",
+    "miss",
+    "hit"
+};
+
+
+// Static initialization runs before main(), close enough to the process start for millisecond resolution.
+static const uint64_t startTs = Chrono::steadyMSecs();
+static std::atomic<uint64_t> durations[Startup::PHASE_MAX];    // duration + 1, zero for phases not finished yet
+static std::atomic<uint64_t> finished{ 0 };
+static std::atomic<uint32_t> topologyCacheStatus{ Startup::CACHE_OFF };
+
+
+static void finish()
+{
+    const uint64_t elapsed = Chrono::steadyMSecs() - startTs;
+    uint64_t current       = finished.load();
+
+    while (current < elapsed && !finished.compare_exchange_weak(current, elapsed)) {}
+}
+
+
+} // namespace xmrig
+
+
+const char *xmrig::Startup::name(Phase phase)
+{
+    return phase < PHASE_MAX ? kPhaseNames[phase] : "unknown";
+}
+
+
+const char *xmrig::Startup::name(TopologyCache cache)
+{
+    return cache <= CACHE_HIT ? kCacheNames[cache] : "unknown";
+}
+
+
+int64_t xmrig::Startup::get(Phase phase)
+{
+    return phase < PHASE_MAX ? static_cast<int64_t>(durations[phase].load(std::memory_order_relaxed)) - 1 : -1;
+}
+
+
+rapidjson::Value xmrig::Startup::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+
+    for (uint32_t i = 0; i < PHASE_MAX; ++i) {
+        const int64_t ms = get(static_cast<Phase>(i));
+
+        out.AddMember(StringRef(kPhaseNames[i]), ms >= 0 ? Value(ms) : Value(kNullType), allocator);
+    }
+
+    out.AddMember("total",          total(), allocator);
+    out.AddMember("topology_cache", StringRef(name(topologyCache())), allocator);
+
+    return out;
+}
+
+
+xmrig::Startup::TopologyCache xmrig::Startup::topologyCache()
+{
+    return static_cast<TopologyCache>(topologyCacheStatus.load(std::memory_order_relaxed));
+}
+
+
+bool xmrig::Startup::set(Phase phase, uint64_t ms)
+{
+    if (phase >= PHASE_MAX) {
+        return false;
+    }
+
+    uint64_t expected = 0;
+    if (!durations[phase].compare_exchange_strong(expected, ms + 1)) {
+        return false;
+    }
+
+    finish();
+
+    return true;
+}
+
+
+uint64_t xmrig::Startup::total()
+{
+    return finished.load(std::memory_order_relaxed);
+}
+
+
+void xmrig::Startup::print()
+{
+    std::string phases;
+
+    for (uint32_t i = 0; i < PHASE_MAX; ++i) {
+        const auto phase = static_cast<Phase>(i);
+        const int64_t ms = get(phase);
+        if (ms < 0) {
+            continue;
+        }
+
+        phases += fmt::format(" {}:" CYAN_BOLD("{}") "ms", name(phase), ms);
+
+        if (phase == TOPOLOGY && topologyCache() != CACHE_OFF) {
+            phases += fmt::format(BLACK_BOLD(" (cache {})"), name(topologyCache()));
+        }
+    }
+
+    if (!phases.empty()) {
+        phases += fmt::format(" total:" WHITE_BOLD("{}") "ms", total());
+    }
+
+    Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-13s") "%s", "STARTUP", phases.empty() ? "" : phases.c_str() + 1);
+}
+
+
+void xmrig::Startup::setMax(Phase phase, uint64_t ms)
+{
+    if (phase >= PHASE_MAX || durations[THREADS].load() != 0) {
+        return;
+    }
+
+    uint64_t current = durations[phase].load();
+    while (current < ms + 1 && !durations[phase].compare_exchange_weak(current, ms + 1)) {}
+
+    finish();
+}
+
+
+void xmrig::Startup::setTopologyCache(TopologyCache cache)
+{
+    topologyCacheStatus = cache;
+}
@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_STARTUP_H
+#define XMRIG_STARTUP_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// Duration of each startup phase, only the first occurrence of a phase is recorded, so a dataset
+// re-initialized for a new seed does not overwrite the startup value. The self-test phase runs on every
+// CPU thread in parallel and keeps the longest one until the threads are ready.
+class Startup
+{
+public:
+    enum Phase : uint32_t {
+        CONFIG,
+        TOPOLOGY,
+        DMI,
+        HUGE_PAGES,
+        SELF_TEST,
+        THREADS,
+        DATASET_ALLOC,
+        DATASET_INIT,
+        PHASE_MAX
+    };
+
+    enum TopologyCache : uint32_t {
+        CACHE_OFF,
+        CACHE_MISS,
+        CACHE_HIT
+    };
+
+    static const char *name(Phase phase);
+    static const char *name(TopologyCache cache);
+    static int64_t get(Phase phase);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static TopologyCache topologyCache();
+    static bool set(Phase phase, uint64_t ms);
+    static uint64_t total();
+    static void print();
+    static void setMax(Phase phase, uint64_t ms);
+    static void setTopologyCache(TopologyCache cache);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_STARTUP_H */
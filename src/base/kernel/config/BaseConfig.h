@@ -49,6 +49,7 @@ public:
     static const char *kDryRun;
     static const char *kHttp;
     static const char *kLogFile;
+    static const char *kLogFileSize;
     static const char *kPrintTime;
     static const char *kSyslog;
     static const char *kTitle;
@@ -73,6 +74,7 @@ public:
     inline const String &apiId() const                      { return m_apiId; }
     inline const String &apiWorkerId() const                { return m_apiWorkerId; }
     inline const Title &title() const                       { return m_title; }
+    inline uint32_t logFileSize() const                     { return m_logFileSize; }
     inline uint32_t printTime() const                       { return m_printTime; }
 
     inline bool isRebenchAlgo() const                       { return m_rebenchAlgo; }
@@ -106,6 +108,7 @@ protected:
     String m_logFile;
     String m_userAgent;
     Title m_title;
+    uint32_t m_logFileSize  = 0;
     uint32_t m_printTime    = 60;
 
     bool m_rebenchAlgo   = false;
@@ -88,6 +88,8 @@ public:
         DaemonZMQPortKey     = 1056,
         HugePagesJitKey      = 1057,
         RotationKey          = 1058,
+        LogFileSizeKey       = 1059,
+        BenchSweepKey        = 1060,
 
         // xmrig common
         CPUPriorityKey       = 1021,
@@ -116,6 +118,10 @@ public:
         YieldKey             = 1030,
         Argon2ImplKey        = 1039,
         RandomXCacheQoSKey   = 1040,
+        RandomXInterpKey     = 1061,
+        RandomXMediumKey     = 1062,
+        RandomXInterleaveKey = 1063,
+        RandomXVerifyKey     = 1064,
 
         // xmrig amd
         OclPlatformKey       = 1400,
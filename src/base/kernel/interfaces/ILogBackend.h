@@ -38,6 +38,7 @@ public:
     ILogBackend()           = default;
     virtual ~ILogBackend()  = default;
 
+    virtual void flush() {}
     virtual void print(uint64_t timestamp, int level, const char *line, size_t offset, size_t size, bool colors) = 0;
 };
 
@@ -26,6 +26,9 @@
 #define XMRIG_ISTRATEGY_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 #include <cstdint>
 
 
@@ -52,6 +55,8 @@ public:
     virtual void setProxy(const ProxyUrl &proxy)       = 0;
     virtual void stop()                                = 0;
     virtual void tick(uint64_t now)                    = 0;
+
+    virtual void toJSON(rapidjson::Value &, rapidjson::Document &) const {}
 };
 
 
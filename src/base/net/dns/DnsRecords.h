@@ -29,7 +29,9 @@ namespace xmrig {
 class DnsRecords
 {
 public:
-    inline bool isEmpty() const       { return m_ipv4.empty() && m_ipv6.empty(); }
+    inline bool isEmpty() const                         { return m_ipv4.empty() && m_ipv6.empty(); }
+    inline const std::vector<DnsRecord> &ipv4() const   { return m_ipv4; }
+    inline const std::vector<DnsRecord> &ipv6() const   { return m_ipv6; }
 
     const DnsRecord &get(DnsRecord::Type prefered = DnsRecord::Unknown) const;
     size_t count(DnsRecord::Type type = DnsRecord::Unknown) const;
@@ -68,6 +68,29 @@ private:
 };
 
 
+// Keeps a buffer shared by several connections alive until its write is done.
+class HttpSharedWriteBaton : public Baton<uv_write_t>
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(HttpSharedWriteBaton)
+
+    inline HttpSharedWriteBaton(const std::shared_ptr<const std::string> &body) :
+        m_body(body)
+    {
+        m_buf = uv_buf_init(const_cast<char *>(m_body->data()), m_body->size());
+    }
+
+    void write(uv_stream_t *stream)
+    {
+        uv_write(&req, stream, &m_buf, 1, [](uv_write_t *req, int) { delete reinterpret_cast<HttpSharedWriteBaton *>(req->data); });
+    }
+
+private:
+    std::shared_ptr<const std::string> m_body;
+    uv_buf_t m_buf{};
+};
+
+
 } // namespace xmrig
 
 
@@ -112,6 +135,17 @@ void xmrig::HttpContext::write(std::string &&data, bool close)
 }
 
 
+void xmrig::HttpContext::write(const std::shared_ptr<const std::string> &data)
+{
+    if (uv_is_writable(stream()) != 1) {
+        return;
+    }
+
+    auto baton = new HttpSharedWriteBaton(data);
+    baton->write(stream());
+}
+
+
 bool xmrig::HttpContext::isRequest() const
 {
     return m_parser->type == HTTP_REQUEST;
@@ -60,6 +60,7 @@ public:
     inline uint16_t port() const override               { return 0; }
 
     void write(std::string &&data, bool close) override;
+    virtual void write(const std::shared_ptr<const std::string> &data);
 
     bool isRequest() const override;
     bool parse(const char *data, size_t size);
@@ -0,0 +1,87 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/http/HttpEventStream.h"
+#include "base/net/http/HttpContext.h"
+
+
+#include <memory>
+#include <string>
+#include <uv.h>
+
+
+namespace xmrig {
+
+
+static const char *kHeaders = "HTTP/1.1 200 OK\r\n"
+                              "Content-Type: text/event-stream\r\n"
+                              "Cache-Control: no-cache\r\n"
+                              "Connection: keep-alive\r\n"
+                              "Access-Control-Allow-Origin: *\r\n"
+                              "\r\n"
+                              "retry: 5000\n\n";
+
+
+} // namespace xmrig
+
+
+bool xmrig::HttpEventStream::subscribe(const HttpData &data)
+{
+    auto ctx = HttpContext::get(data.id());
+    if (!ctx || m_subscribers.size() >= kMaxSubscribers) {
+        return false;
+    }
+
+    ctx->write(kHeaders, false);
+    m_subscribers.push_back(data.id());
+
+    return true;
+}
+
+
+void xmrig::HttpEventStream::publish(const char *event, const char *data, size_t size)
+{
+    if (m_subscribers.empty()) {
+        return;
+    }
+
+    auto buf = std::make_shared<std::string>();
+    buf->reserve(size + 16);
+    buf->append("event: ").append(event).append("\ndata: ").append(data, size).append("\n\n");
+
+    const std::shared_ptr<const std::string> payload(std::move(buf));
+
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end();) {
+        auto ctx = HttpContext::get(*it);
+
+        if (!ctx || uv_is_writable(ctx->stream()) != 1) {
+            it = m_subscribers.erase(it);
+            continue;
+        }
+
+        if (ctx->stream()->write_queue_size > kMaxQueueSize) {
+            ctx->close();
+            it = m_subscribers.erase(it);
+            continue;
+        }
+
+        ctx->write(payload);
+        ++it;
+    }
+}
@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_HTTPEVENTSTREAM_H
+#define XMRIG_HTTPEVENTSTREAM_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class HttpData;
+
+
+/**
+ * Server-sent events (text/event-stream) over keep-alive HTTP connections.
+ *
+ * Each event is formatted once and the same buffer is written to every subscriber,
+ * subscribers that stopped reading are dropped instead of growing the write queue.
+ */
+class HttpEventStream
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(HttpEventStream)
+
+    constexpr static size_t kMaxSubscribers = 32;
+    constexpr static size_t kMaxQueueSize   = 1024 * 1024;
+
+    HttpEventStream()   = default;
+    ~HttpEventStream()  = default;
+
+    inline bool isEmpty() const     { return m_subscribers.empty(); }
+    inline size_t size() const      { return m_subscribers.size(); }
+
+    bool subscribe(const HttpData &data);
+    void publish(const char *event, const char *data, size_t size);
+
+private:
+    std::vector<uint64_t> m_subscribers;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_HTTPEVENTSTREAM_H
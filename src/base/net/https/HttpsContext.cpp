@@ -96,3 +96,16 @@ void xmrig::HttpsContext::write(std::string &&data, bool close)
         HttpContext::write(std::move(data), close);
     }
 }
+
+
+void xmrig::HttpsContext::write(const std::shared_ptr<const std::string> &data)
+{
+    m_close = false;
+
+    if (m_mode == TLS_ON) {
+        send(data->data(), data->size());
+    }
+    else {
+        HttpContext::write(data);
+    }
+}
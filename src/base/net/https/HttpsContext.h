@@ -53,6 +53,7 @@ protected:
 
     // HttpContext
     void write(std::string &&data, bool close) override;
+    void write(const std::shared_ptr<const std::string> &data) override;
 
 private:
     enum TlsMode : uint32_t {
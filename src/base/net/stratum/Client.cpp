@@ -17,6 +17,7 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <iterator>
@@ -44,8 +45,10 @@
 #include "base/kernel/interfaces/IClientListener.h"
 #include "base/net/dns/Dns.h"
 #include "base/net/dns/DnsRecords.h"
+#include "base/net/stratum/Connector.h"
 #include "base/net/stratum/Socks5.h"
 #include "base/net/tools/NetBuffer.h"
+#include "base/tools/Baton.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "base/tools/cryptonote/BlobReader.h"
@@ -60,6 +63,50 @@
 namespace xmrig {
 
 Storage<Client> Client::m_storage;
+Client::WriteStats Client::m_writeStats;
+
+
+class ClientWriteBaton : public Baton<uv_write_t>
+{
+public:
+    inline ClientWriteBaton(void *key, std::vector<char> &&queue, const std::vector<size_t> &sizes) :
+        key(key),
+        data(std::move(queue))
+    {
+        bufs.reserve(sizes.size());
+
+        size_t offset = 0;
+        for (size_t size : sizes) {
+            bufs.emplace_back(uv_buf_init(data.data() + offset, static_cast<unsigned int>(size)));
+            offset += size;
+        }
+    }
+
+    void *key;
+    std::vector<char> data;
+    std::vector<uv_buf_t> bufs;
+};
+
+
+// Clients with queued messages, flushed together by a check handle right after the poll phase, so messages queued
+// from socket reads and async share submits go out in the same loop iteration. The idle handle only keeps poll from
+// blocking while messages queued from timers are waiting.
+static std::vector<void *> pendingFlush;
+static uv_check_t *flushHandle = nullptr;
+static uv_idle_t *wakeHandle   = nullptr;
+
+
+static void removePendingFlush(void *key)
+{
+    pendingFlush.erase(std::remove(pendingFlush.begin(), pendingFlush.end(), key), pendingFlush.end());
+
+    if (pendingFlush.empty() && flushHandle) {
+        uv_close(reinterpret_cast<uv_handle_t *>(flushHandle), [](uv_handle_t *handle) { delete reinterpret_cast<uv_check_t *>(handle); });
+        uv_close(reinterpret_cast<uv_handle_t *>(wakeHandle), [](uv_handle_t *handle) { delete reinterpret_cast<uv_idle_t *>(handle); });
+        flushHandle = nullptr;
+        wakeHandle  = nullptr;
+    }
+}
 
 } /* namespace xmrig */
 
@@ -79,6 +126,7 @@ static const char *states[] = {
 xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
     BaseClient(id, listener),
     m_agent(agent),
+    m_connector(new Connector(this)),
     m_sendBuf(1024),
     m_tempBuf(256)
 {
@@ -89,6 +137,9 @@ xmrig::Client::Client(int id, const char *agent, IClientListener *listener) :
 
 xmrig::Client::~Client()
 {
+    removePendingFlush(m_storage.ptr(m_key));
+
+    delete m_connector;
     delete m_socket;
 }
 
@@ -113,6 +164,16 @@ bool xmrig::Client::isTLS() const
 }
 
 
+bool xmrig::Client::isTLSResumed() const
+{
+#   ifdef XMRIG_FEATURE_TLS
+    return isTLS() && m_tls->isResumed();
+#   else
+    return false;
+#   endif
+}
+
+
 const char *xmrig::Client::tlsFingerprint() const
 {
 #   ifdef XMRIG_FEATURE_TLS
@@ -137,6 +198,18 @@ const char *xmrig::Client::tlsVersion() const
 }
 
 
+double xmrig::Client::tlsResumption() const
+{
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        return m_tls->resumption();
+    }
+#   endif
+
+    return 0.0;
+}
+
+
 int64_t xmrig::Client::send(const rapidjson::Value &obj, Callback callback)
 {
     assert(obj["id"] == sequence());
@@ -242,6 +315,18 @@ int64_t xmrig::Client::submit(const JobResult &result)
 }
 
 
+uint64_t xmrig::Client::tlsHandshakeTime() const
+{
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        return m_tls->handshakeTime();
+    }
+#   endif
+
+    return 0;
+}
+
+
 void xmrig::Client::connect()
 {
     if (m_pool.proxy().isValid()) {
@@ -303,6 +388,10 @@ void xmrig::Client::tick(uint64_t now)
     if (m_state == ConnectingState && m_expire && now > m_expire) {
         close();
     }
+
+    if (m_state == ClosingState && m_expire && now > m_expire && m_socket && uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
+        uv_close(reinterpret_cast<uv_handle_t*>(m_socket), Client::onClose);
+    }
 }
 
 
@@ -323,26 +412,62 @@ void xmrig::Client::onResolved(const DnsRecords &records, int status, const char
         return reconnect();
     }
 
-    const auto &record = records.get();
-    m_ip = record.ip();
+    setState(ConnectingState);
 
-    connect(record.addr(m_socks5 ? m_pool.proxy().port() : m_pool.port()));
+    m_connector->connect(records, m_socks5 ? m_pool.proxy().port() : m_pool.port());
 }
 
 
 bool xmrig::Client::close()
 {
     if (m_state == ClosingState) {
-        return m_socket != nullptr;
+        // A deleted client is not ticked anymore, do not wait for a pending shutdown.
+        if (!m_listener && m_socket && uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
+            uv_close(reinterpret_cast<uv_handle_t*>(m_socket), Client::onClose);
+        }
+
+        return m_socket != nullptr || m_connector->isPending();
     }
 
-    if (m_state == UnconnectedState || m_socket == nullptr) {
+    if (m_state == UnconnectedState) {
         return false;
     }
 
+    if (m_socket == nullptr) {
+        if (!m_connector->close()) {
+            return false;
+        }
+
+        setState(ClosingState);
+
+        return true;
+    }
+
+    if (m_state == ConnectedState) {
+        flush();
+    }
+
+    // Closing the handle cancels writes libuv could not send yet, shut the write side down first so they are
+    // sent and close the handle when the shutdown completes or after kShutdownTimeout.
+    const bool drain = m_state == ConnectedState && m_listener && stream()->write_queue_size > 0;
+
     setState(ClosingState);
 
     if (uv_is_closing(reinterpret_cast<uv_handle_t*>(m_socket)) == 0) {
+        if (drain) {
+            uv_read_stop(stream());
+
+            auto req = new uv_shutdown_t;
+
+            if (uv_shutdown(req, stream(), onShutdown) == 0) {
+                m_expire = Chrono::steadyMSecs() + kShutdownTimeout;
+
+                return true;
+            }
+
+            delete req;
+        }
+
         uv_close(reinterpret_cast<uv_handle_t*>(m_socket), Client::onClose);
     }
 
@@ -350,6 +475,42 @@ bool xmrig::Client::close()
 }
 
 
+bool xmrig::Client::flush()
+{
+    removePendingFlush(m_storage.ptr(m_key));
+
+    if (m_writeSizes.empty()) {
+        return true;
+    }
+
+    const size_t count = m_writeSizes.size();
+    auto baton         = new ClientWriteBaton(m_storage.ptr(m_key), std::move(m_writeQueue), m_writeSizes);
+
+    m_writeQueue.clear();
+    m_writeSizes.clear();
+    m_writeQueued = 0;
+
+    const int rc = uv_write(&baton->req, stream(), baton->bufs.data(), static_cast<unsigned int>(baton->bufs.size()), onWrite);
+    if (rc < 0) {
+        delete baton;
+
+        if (!isQuiet()) {
+            LOG_ERR("%s " RED("write error: ") RED_BOLD("\"%s\""), tag(), uv_strerror(rc));
+        }
+
+        close();
+
+        return false;
+    }
+
+    m_writeStats.writes++;
+    m_writeStats.messages += count;
+    m_writeStats.maxBatch  = std::max<uint64_t>(m_writeStats.maxBatch, count);
+
+    return true;
+}
+
+
 bool xmrig::Client::parseJob(const rapidjson::Value &params, int *code)
 {
     if (!params.IsObject()) {
@@ -493,18 +654,26 @@ bool xmrig::Client::verifyAlgorithm(const Algorithm &algorithm, const char *algo
 
 bool xmrig::Client::write(const uv_buf_t &buf)
 {
-    const int rc = uv_try_write(stream(), &buf, 1);
-    if (static_cast<size_t>(rc) == buf.len) {
-        return true;
+    if (!m_socket) {
+        return false;
     }
 
-    if (!isQuiet()) {
-        LOG_ERR("%s " RED("write error: ") RED_BOLD("\"%s\""), tag(), uv_strerror(rc));
+    const uint64_t now = Chrono::steadyMSecs();
+    if (m_writeSizes.empty()) {
+        m_writeQueued = now;
     }
 
-    close();
+    m_writeQueue.insert(m_writeQueue.end(), buf.base, buf.base + buf.len);
+    m_writeSizes.push_back(buf.len);
 
-    return false;
+    // Caps keep a single share from waiting behind a large or slow batch.
+    if (m_writeQueue.size() >= kMaxWriteBatchSize || m_writeSizes.size() >= kMaxWriteBatchCount || now - m_writeQueued >= kMaxWriteDelay) {
+        return flush();
+    }
+
+    scheduleFlush();
+
+    return true;
 }
 
 
@@ -554,27 +723,6 @@ int64_t xmrig::Client::send(size_t size)
 }
 
 
-void xmrig::Client::connect(const sockaddr *addr)
-{
-    setState(ConnectingState);
-
-    auto req = new uv_connect_t;
-    req->data = m_storage.ptr(m_key);
-
-    m_socket = new uv_tcp_t;
-    m_socket->data = m_storage.ptr(m_key);
-
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
-
-#   ifndef WIN32
-    uv_tcp_keepalive(m_socket, 1, 60);
-#   endif
-
-    uv_tcp_connect(req, m_socket, addr, onConnect);
-}
-
-
 void xmrig::Client::handshake()
 {
     if (m_socks5) {
@@ -590,7 +738,7 @@ void xmrig::Client::handshake()
     else
 #   endif
     {
-        login();
+        onHandshake();
     }
 }
 
@@ -639,10 +787,13 @@ void xmrig::Client::login()
 
 void xmrig::Client::onClose()
 {
+    removePendingFlush(m_storage.ptr(m_key));
+    m_writeQueue.clear();
+    m_writeSizes.clear();
+
     delete m_socket;
 
     m_socket = nullptr;
-    setState(UnconnectedState);
 
 #   ifdef XMRIG_FEATURE_TLS
     if (m_tls) {
@@ -651,6 +802,29 @@ void xmrig::Client::onClose()
     }
 #   endif
 
+    // The handshake failed before login, continue with another address of the same connect instead of reconnecting.
+    if (m_failures != -1 && m_listener && m_connector->canFallback()) {
+        setState(ConnectingState);
+        m_reader.reset();
+
+        delete m_socks5;
+        m_socks5 = nullptr;
+
+        if (m_pool.proxy().isValid()) {
+            m_socks5 = new Socks5(this);
+        }
+#       ifdef XMRIG_FEATURE_TLS
+        else if (m_pool.isTLS()) {
+            m_tls = new Tls(this);
+        }
+#       endif
+
+        return m_connector->fallback();
+    }
+
+    m_connector->done();
+    setState(UnconnectedState);
+
     reconnect();
 }
 
@@ -801,6 +975,28 @@ void xmrig::Client::parseNotification(const char *method, const rapidjson::Value
 }
 
 
+void xmrig::Client::onHandshake()
+{
+    m_connector->done();
+
+    login();
+}
+
+
+void xmrig::Client::onConnected(uv_tcp_t *socket, const String &ip)
+{
+    m_ip           = ip;
+    m_socket       = socket;
+    m_socket->data = m_storage.ptr(m_key);
+
+    setState(ConnectedState);
+
+    uv_read_start(stream(), NetBuffer::onAlloc, onRead);
+
+    handshake();
+}
+
+
 void xmrig::Client::parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error)
 {
     if (handleResponse(id, result, error)) {
@@ -929,6 +1125,27 @@ void xmrig::Client::reconnect()
 }
 
 
+void xmrig::Client::scheduleFlush()
+{
+    void *key = m_storage.ptr(m_key);
+    if (std::find(pendingFlush.begin(), pendingFlush.end(), key) != pendingFlush.end()) {
+        return;
+    }
+
+    pendingFlush.push_back(key);
+
+    if (!flushHandle) {
+        flushHandle = new uv_check_t;
+        uv_check_init(uv_default_loop(), flushHandle);
+        uv_check_start(flushHandle, onFlush);
+
+        wakeHandle = new uv_idle_t;
+        uv_idle_init(uv_default_loop(), wakeHandle);
+        uv_idle_start(wakeHandle, [](uv_idle_t *) {});
+    }
+}
+
+
 void xmrig::Client::setState(SocketState state)
 {
     LOG_DEBUG("[%s] state: \"%s\" -> \"%s\"", url(), states[m_state], states[state]);
@@ -1007,41 +1224,27 @@ void xmrig::Client::onClose(uv_handle_t *handle)
 }
 
 
-void xmrig::Client::onConnect(uv_connect_t *req, int status)
+void xmrig::Client::onFlush(uv_check_t *)
 {
-    auto client = getClient(req->data);
-    delete req;
+    std::vector<void *> keys;
+    keys.swap(pendingFlush);
 
-    if (!client) {
-        return;
-    }
-
-    if (status < 0) {
-        if (!client->isQuiet()) {
-            LOG_ERR("%s " RED("connect error: ") RED_BOLD("\"%s\""), client->tag(), uv_strerror(status));
+    for (void *key : keys) {
+        auto client = getClient(key);
+        if (!client) {
+            continue;
         }
 
-        if (client->state() == ReconnectingState || client->state() == ClosingState) {
-            return;
+        if (client->m_state == ConnectedState) {
+            client->flush();
         }
-
-        if (client->state() != ConnectingState) {
-            return;
+        else {
+            client->m_writeQueue.clear();
+            client->m_writeSizes.clear();
         }
-
-        client->close();
-        return;
     }
 
-    if (client->state() == ConnectedState) {
-        return;
-    }
-
-    client->setState(ConnectedState);
-
-    uv_read_start(client->stream(), NetBuffer::onAlloc, onRead);
-
-    client->handshake();
+    removePendingFlush(nullptr);
 }
 
 
@@ -1054,3 +1257,33 @@ void xmrig::Client::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *b
 
     NetBuffer::release(buf);
 }
+
+
+void xmrig::Client::onShutdown(uv_shutdown_t *req, int)
+{
+    auto handle = reinterpret_cast<uv_handle_t *>(req->handle);
+    delete req;
+
+    if (uv_is_closing(handle) == 0) {
+        uv_close(handle, Client::onClose);
+    }
+}
+
+
+void xmrig::Client::onWrite(uv_write_t *req, int status)
+{
+    auto baton = static_cast<ClientWriteBaton *>(req->data);
+
+    if (status < 0 && status != UV_ECANCELED) {
+        auto client = getClient(baton->key);
+        if (client) {
+            if (!client->isQuiet()) {
+                LOG_ERR("%s " RED("write error: ") RED_BOLD("\"%s\""), client->tag(), uv_strerror(status));
+            }
+
+            client->close();
+        }
+    }
+
+    delete baton;
+}
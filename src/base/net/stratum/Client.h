@@ -56,19 +56,37 @@ public:
 
     constexpr static uint64_t kConnectTimeout   = 20 * 1000;
     constexpr static uint64_t kResponseTimeout  = 20 * 1000;
+    constexpr static uint64_t kShutdownTimeout  = 2 * 1000;
     constexpr static size_t kMaxSendBufferSize  = 1024 * 16;
+    constexpr static size_t kMaxWriteBatchSize  = 1024 * 16;
+    constexpr static size_t kMaxWriteBatchCount = 64;
+    constexpr static uint64_t kMaxWriteDelay    = 2;
+
+    struct WriteStats
+    {
+        uint64_t writes     = 0;
+        uint64_t messages   = 0;
+        uint64_t maxBatch   = 0;
+    };
 
     Client(int id, const char *agent, IClientListener *listener);
     ~Client() override;
 
+    static inline const WriteStats &writeStats()                            { return m_writeStats; }
+
+    static void releaseTls();
+
 protected:
     bool disconnect() override;
     bool isTLS() const override;
+    bool isTLSResumed() const override;
     const char *tlsFingerprint() const override;
     const char *tlsVersion() const override;
+    double tlsResumption() const override;
     int64_t send(const rapidjson::Value &obj, Callback callback) override;
     int64_t send(const rapidjson::Value &obj) override;
     int64_t submit(const JobResult &result) override;
+    uint64_t tlsHandshakeTime() const override;
     void connect() override;
     void connect(const Pool &pool) override;
     void deleteLater() override;
@@ -94,23 +112,27 @@ protected:
     virtual void onClose();
 
 private:
+    class Connector;
     class Socks5;
     class Tls;
 
+    bool flush();
     bool parseJob(const rapidjson::Value &params, int *code);
     bool send(BIO *bio);
     bool verifyAlgorithm(const Algorithm &algorithm, const char *algo) const;
     bool write(const uv_buf_t &buf);
     int resolve(const String &host);
     int64_t send(size_t size);
-    void connect(const sockaddr *addr);
     void handshake();
     void parse(char *line, size_t len);
     void parseExtensions(const rapidjson::Value &result);
+    void onConnected(uv_tcp_t *socket, const String &ip);
+    void onHandshake();
     void parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
     void ping();
     void read(ssize_t nread, const uv_buf_t *buf);
     void reconnect();
+    void scheduleFlush();
     void setState(SocketState state);
     void startTimeout();
 
@@ -121,27 +143,34 @@ private:
 
     static bool isCriticalError(const char *message);
     static void onClose(uv_handle_t *handle);
-    static void onConnect(uv_connect_t *req, int status);
+    static void onFlush(uv_check_t *handle);
     static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+    static void onShutdown(uv_shutdown_t *req, int status);
+    static void onWrite(uv_write_t *req, int status);
 
     static inline Client *getClient(void *data) { return m_storage.get(data); }
 
     const char *m_agent;
+    Connector *m_connector;
     LineReader m_reader;
     Socks5 *m_socks5            = nullptr;
     std::bitset<EXT_MAX> m_extensions;
     std::shared_ptr<DnsRequest> m_dns;
     std::vector<char> m_sendBuf;
     std::vector<char> m_tempBuf;
+    std::vector<char> m_writeQueue;
+    std::vector<size_t> m_writeSizes;
     String m_rpcId;
     Tls *m_tls                  = nullptr;
     uint64_t m_expire           = 0;
     uint64_t m_jobs             = 0;
     uint64_t m_keepAlive        = 0;
+    uint64_t m_writeQueued      = 0;
     uintptr_t m_key             = 0;
     uv_tcp_t *m_socket          = nullptr;
 
     static Storage<Client> m_storage;
+    static WriteStats m_writeStats;
 };
 
 
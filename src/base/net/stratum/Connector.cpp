@@ -0,0 +1,364 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/Connector.h"
+#include "base/io/log/Log.h"
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/net/dns/Dns.h"
+#include "base/net/dns/DnsRecords.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+
+namespace xmrig {
+
+
+std::map<String, uint64_t> Client::Connector::m_times;
+
+
+static constexpr uint64_t kUnknownTime  = Client::kConnectTimeout;
+static constexpr uint64_t kFailedTime   = Client::kConnectTimeout * 2;
+
+
+struct Client::Connector::Attempt
+{
+    inline Attempt(Connector *connector, const DnsRecord &record) :
+        connector(connector),
+        ip(record.ip()),
+        ts(Chrono::steadyMSecs())
+    {}
+
+    bool connected      = false;
+    Connector *connector;
+    String ip;
+    uint64_t elapsed    = 0;
+    uint64_t ts;
+    uv_tcp_t *socket    = nullptr;
+};
+
+
+using Candidates = std::vector<std::pair<uint64_t, const DnsRecord *> >;
+
+
+static Candidates candidates(const std::vector<DnsRecord> &records, const std::map<String, uint64_t> &times)
+{
+    Candidates out;
+    out.reserve(records.size());
+
+    // Addresses without history keep the random start from DnsRecords::get() to spread the load.
+    const size_t size   = records.size();
+    const size_t offset = size > 1 ? static_cast<size_t>(rand()) % size : 0; // NOLINT(concurrency-mt-unsafe, cert-msc30-c, cert-msc50-cpp)
+
+    for (size_t i = 0; i < size; ++i) {
+        const auto &record = records[(i + offset) % size];
+        const auto it      = times.find(record.ip());
+
+        out.emplace_back(it != times.end() ? it->second : kUnknownTime, &record);
+    }
+
+    std::stable_sort(out.begin(), out.end(), [](const Candidates::value_type &a, const Candidates::value_type &b) { return a.first < b.first; });
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Client::Connector::Connector(Client *client) :
+    m_client(client),
+    m_timer(new Timer(this))
+{
+}
+
+
+xmrig::Client::Connector::~Connector()
+{
+    cancel();
+
+    delete m_timer;
+}
+
+
+bool xmrig::Client::Connector::close()
+{
+    if (m_attempts.empty()) {
+        return false;
+    }
+
+    m_closing = true;
+    m_racing  = false;
+    m_waiting = false;
+    m_index   = m_records.size();
+    m_timer->stop();
+
+    for (auto attempt : m_attempts) {
+        auto handle = reinterpret_cast<uv_handle_t *>(attempt->socket);
+        if (uv_is_closing(handle) == 0) {
+            uv_close(handle, onClose);
+        }
+    }
+
+    return true;
+}
+
+
+void xmrig::Client::Connector::connect(const DnsRecords &records, uint16_t port)
+{
+    cancel();
+
+    m_records.clear();
+    m_records.reserve(records.count());
+    m_index = 0;
+    m_error = 0;
+    m_port  = port;
+
+    const auto ipv4 = candidates(records.ipv4(), m_times);
+    const auto ipv6 = candidates(records.ipv6(), m_times);
+
+    bool ipv6First = ipv4.empty();
+    if (!ipv4.empty() && !ipv6.empty()) {
+        ipv6First = ipv6.front().first < ipv4.front().first || (ipv6.front().first == ipv4.front().first && Dns::config().isIPv6());
+    }
+
+    const auto &first  = ipv6First ? ipv6 : ipv4;
+    const auto &second = ipv6First ? ipv4 : ipv6;
+
+    for (size_t i = 0; i < std::max(first.size(), second.size()); ++i) {
+        if (i < first.size()) {
+            m_records.emplace_back(*first[i].second);
+        }
+
+        if (i < second.size()) {
+            m_records.emplace_back(*second[i].second);
+        }
+    }
+
+    if (m_records.empty()) {
+        return m_client->onClose();
+    }
+
+    next();
+}
+
+
+void xmrig::Client::Connector::done()
+{
+    if (m_racing) {
+        cancel();
+    }
+}
+
+
+void xmrig::Client::Connector::fallback()
+{
+    m_times[m_client->m_ip] = kFailedTime;
+
+    Attempt *best = nullptr;
+    for (auto attempt : m_attempts) {
+        if (attempt->connected && (!best || attempt->elapsed < best->elapsed)) {
+            best = attempt;
+        }
+    }
+
+    if (best) {
+        LOG_DEBUG("[%s] handshake failed, fallback to %s", m_client->url(), best->ip.data());
+
+        return handover(best);
+    }
+
+    m_waiting = true;
+
+    if (m_attempts.empty()) {
+        next();
+    }
+    else if (m_index < m_records.size()) {
+        m_timer->singleShot(kAttemptDelay);
+    }
+}
+
+
+void xmrig::Client::Connector::onTimer(const Timer *)
+{
+    next();
+}
+
+
+void xmrig::Client::Connector::onClose(uv_handle_t *handle)
+{
+    auto attempt = static_cast<Attempt *>(handle->data);
+    delete reinterpret_cast<uv_tcp_t *>(handle);
+
+    if (attempt->connector) {
+        attempt->connector->onClosed(attempt);
+    }
+
+    delete attempt;
+}
+
+
+void xmrig::Client::Connector::onConnect(uv_connect_t *req, int status)
+{
+    auto attempt = static_cast<Attempt *>(req->data);
+    delete req;
+
+    if (attempt->connector && status != UV_ECANCELED) {
+        attempt->connector->onResult(attempt, status);
+    }
+}
+
+
+void xmrig::Client::Connector::cancel()
+{
+    m_timer->stop();
+
+    for (auto attempt : m_attempts) {
+        attempt->connector = nullptr;
+
+        auto handle = reinterpret_cast<uv_handle_t *>(attempt->socket);
+        if (uv_is_closing(handle) == 0) {
+            uv_close(handle, onClose);
+        }
+    }
+
+    m_attempts.clear();
+    m_closing = false;
+    m_racing  = false;
+    m_waiting = false;
+}
+
+
+void xmrig::Client::Connector::handover(Attempt *attempt)
+{
+    m_attempts.erase(std::remove(m_attempts.begin(), m_attempts.end(), attempt), m_attempts.end());
+    m_waiting = false;
+
+    m_client->onConnected(attempt->socket, attempt->ip);
+
+    delete attempt;
+}
+
+
+void xmrig::Client::Connector::next()
+{
+    while (m_index < m_records.size()) {
+        auto &record = m_records[m_index++];
+        auto attempt = new Attempt(this, record);
+
+        attempt->socket       = new uv_tcp_t;
+        attempt->socket->data = attempt;
+
+        uv_tcp_init(uv_default_loop(), attempt->socket);
+        uv_tcp_nodelay(attempt->socket, 1);
+
+#       ifndef WIN32
+        uv_tcp_keepalive(attempt->socket, 1, 60);
+#       endif
+
+        m_attempts.push_back(attempt);
+
+        auto req  = new uv_connect_t;
+        req->data = attempt;
+
+        const int rc = uv_tcp_connect(req, attempt->socket, record.addr(m_port), onConnect);
+        if (rc < 0) {
+            delete req;
+
+            m_error = rc;
+            uv_close(reinterpret_cast<uv_handle_t *>(attempt->socket), onClose);
+
+            continue;
+        }
+
+        if (m_index < m_records.size()) {
+            m_timer->singleShot(kAttemptDelay);
+        }
+
+        return;
+    }
+}
+
+
+void xmrig::Client::Connector::onClosed(Attempt *attempt)
+{
+    m_attempts.erase(std::remove(m_attempts.begin(), m_attempts.end(), attempt), m_attempts.end());
+
+    // Standby attempts that fail while the client handshake is in progress are simply dropped.
+    if (m_racing && !m_waiting) {
+        return;
+    }
+
+    if (!m_attempts.empty() || (!m_closing && m_index < m_records.size())) {
+        return;
+    }
+
+    if (!m_closing && m_error < 0 && !m_client->isQuiet()) {
+        LOG_ERR("%s " RED("connect error: ") RED_BOLD("\"%s\""), m_client->tag(), uv_strerror(m_error));
+    }
+
+    m_closing = false;
+    m_racing  = false;
+    m_client->onClose();
+}
+
+
+void xmrig::Client::Connector::onResult(Attempt *attempt, int status)
+{
+    if (status < 0) {
+        LOG_DEBUG_ERR("[%s] connect to %s failed: \"%s\"", m_client->url(), attempt->ip.data(), uv_strerror(status));
+
+        m_error               = status;
+        m_times[attempt->ip]  = kFailedTime;
+
+        uv_close(reinterpret_cast<uv_handle_t *>(attempt->socket), onClose);
+
+        if (m_racing && !m_waiting) {
+            return;
+        }
+
+        // Do not wait for the attempt delay if an address has definitely failed.
+        m_timer->stop();
+        next();
+
+        return;
+    }
+
+    const uint64_t elapsed = Chrono::steadyMSecs() - attempt->ts;
+    m_times[attempt->ip]   = elapsed;
+
+    LOG_DEBUG("[%s] connected to %s in %" PRIu64 " ms", m_client->url(), attempt->ip.data(), elapsed);
+
+    // The client is busy with the handshake on an earlier connection, keep this one as a standby.
+    if (m_racing && !m_waiting) {
+        attempt->connected = true;
+        attempt->elapsed   = elapsed;
+
+        return;
+    }
+
+    m_racing = true;
+    m_timer->stop();
+
+    handover(attempt);
+}
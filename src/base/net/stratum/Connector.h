@@ -0,0 +1,98 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CONNECTOR_H
+#define XMRIG_CONNECTOR_H
+
+
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/net/dns/DnsRecord.h"
+#include "base/net/stratum/Client.h"
+
+
+#include <map>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class DnsRecords;
+
+
+/**
+ * Happy eyeballs (RFC 8305) connection racing across all resolved addresses.
+ *
+ * Attempts are started with a fixed delay, alternating address families, and the first
+ * established TCP connection is handed to the client. Other attempts stay alive until the
+ * client reports that its TLS/SOCKS5 handshake completed, if it fails or stalls the client
+ * falls back to the fastest standby connection. Connect times are remembered per address
+ * for the lifetime of the process, so later reconnects try the fastest known address first.
+ */
+class Client::Connector : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Connector)
+
+    constexpr static uint64_t kAttemptDelay = 250;
+
+    Connector(Client *client);
+    ~Connector() override;
+
+    inline bool canFallback() const { return m_racing && (!m_attempts.empty() || m_index < m_records.size()); }
+    inline bool isPending() const   { return !m_attempts.empty(); }
+
+    bool close();
+    void connect(const DnsRecords &records, uint16_t port);
+    void done();
+    void fallback();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    struct Attempt;
+
+    static void onClose(uv_handle_t *handle);
+    static void onConnect(uv_connect_t *req, int status);
+
+    void cancel();
+    void handover(Attempt *attempt);
+    void next();
+    void onClosed(Attempt *attempt);
+    void onResult(Attempt *attempt, int status);
+
+    bool m_closing      = false;
+    bool m_racing       = false;
+    bool m_waiting      = false;
+    Client *m_client;
+    int m_error         = 0;
+    size_t m_index      = 0;
+    std::vector<Attempt *> m_attempts;
+    std::vector<DnsRecord> m_records;
+    Timer *m_timer;
+    uint16_t m_port     = 0;
+
+    static std::map<String, uint64_t> m_times;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CONNECTOR_H */
@@ -76,6 +76,9 @@ protected:
     inline const char *mode() const override                            { return "daemon"; }
     inline const char *tlsFingerprint() const override                  { return m_tlsFingerprint; }
     inline const char *tlsVersion() const override                      { return m_tlsVersion; }
+    inline bool isTLSResumed() const override                           { return false; }
+    inline double tlsResumption() const override                        { return 0.0; }
+    inline uint64_t tlsHandshakeTime() const override                   { return 0; }
     inline int64_t send(const rapidjson::Value &, Callback) override    { return -1; }
     inline int64_t send(const rapidjson::Value &) override              { return -1; }
     void deleteLater() override;
@@ -18,9 +18,11 @@
 
 #include "base/net/stratum/NetworkState.h"
 #include "3rdparty/rapidjson/document.h"
+#include "base/api/MetricsWriter.h"
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IClient.h"
 #include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Client.h"
 #include "base/net/stratum/Job.h"
 #include "base/net/stratum/Pool.h"
 #include "base/net/stratum/SubmitResult.h"
@@ -28,6 +30,7 @@
 
 
 #include <algorithm>
+#include <cctype>
 #include <cstdio>
 #include <cstring>
 #include <uv.h>
@@ -92,6 +95,29 @@ inline static void printDiff(size_t i, uint64_t diff, uint64_t hashes)
 }
 
 
+static bool isStale(const char *error)
+{
+    static const char *patterns[] = { "stale", "expired", "outdated" };
+
+    for (const char *pattern : patterns) {
+        const size_t size = strlen(pattern);
+
+        for (const char *c = error; *c; ++c) {
+            size_t i = 0;
+            while (i < size && c[i] && tolower(static_cast<unsigned char>(c[i])) == pattern[i]) {
+                ++i;
+            }
+
+            if (i == size) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
 inline static void printLatency(uint32_t latency)
 {
     if (!latency) {
@@ -129,6 +155,12 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("tls",             m_tls.toJSON(), allocator);
     connection.AddMember("tls-fingerprint", m_fingerprint.toJSON(), allocator);
 
+    if (!m_tls.isNull()) {
+        connection.AddMember("tls_handshake_ms", m_tlsHandshakeTime, allocator);
+        connection.AddMember("tls_resumed",      m_tlsResumed, allocator);
+        connection.AddMember("tls_resumption",   m_tlsResumption, allocator);
+    }
+
     connection.AddMember("algo",            m_algorithm.toJSON(), allocator);
     connection.AddMember("diff",            m_diff, allocator);
     connection.AddMember("accepted",        m_accepted, allocator);
@@ -137,6 +169,15 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("avg_time_ms",     avgTime(), allocator);
     connection.AddMember("hashes_total",    m_hashes, allocator);
 
+    const auto &stats = Client::writeStats();
+    Value writes(kObjectType);
+    writes.AddMember("total",       stats.writes, allocator);
+    writes.AddMember("messages",    stats.messages, allocator);
+    writes.AddMember("per_write",   stats.writes ? static_cast<double>(stats.messages) / stats.writes : 0.0, allocator);
+    writes.AddMember("max",         stats.maxBatch, allocator);
+
+    connection.AddMember("writes",          writes, allocator);
+
     if (version == 1) {
         connection.AddMember("error_log", Value(kArrayType), allocator);
     }
@@ -174,6 +215,41 @@ rapidjson::Value xmrig::NetworkState::getResults(rapidjson::Document &doc, int v
 
     return results;
 }
+
+
+void xmrig::NetworkState::getMetrics(MetricsWriter &metrics) const
+{
+    const char *pool = m_active ? m_pool : "";
+
+    metrics.add("xmrig_pool_connected", MetricsWriter::GAUGE, "Whether a pool connection is active.");
+    metrics.sample("xmrig_pool_connected", { { "pool", pool }, { "algo", m_algorithm.isValid() ? m_algorithm.name() : "" } }, static_cast<uint64_t>(m_active));
+
+    metrics.add("xmrig_pool_latency_seconds", MetricsWriter::GAUGE, "Median share round-trip time for the active pool.");
+    metrics.sample("xmrig_pool_latency_seconds", { { "pool", pool } }, latency() / 1000.0);
+
+    metrics.add("xmrig_pool_difficulty", MetricsWriter::GAUGE, "Difficulty of the current job.");
+    metrics.sample("xmrig_pool_difficulty", { { "pool", pool } }, m_diff);
+
+    metrics.add("xmrig_pool_failures_total", MetricsWriter::COUNTER, "Lost pool connections.");
+    metrics.sample("xmrig_pool_failures_total", m_failures);
+
+    metrics.add("xmrig_jobs_total", MetricsWriter::COUNTER, "Jobs received from pools.");
+    metrics.sample("xmrig_jobs_total", m_jobs);
+
+    metrics.add("xmrig_shares_total", MetricsWriter::COUNTER, "Submitted shares by pool verdict, stale shares are also counted as rejected.");
+    metrics.sample("xmrig_shares_total", { { "result", "accepted" } }, m_accepted);
+    metrics.sample("xmrig_shares_total", { { "result", "rejected" } }, m_rejected);
+    metrics.sample("xmrig_shares_total", { { "result", "stale" } }, m_stale);
+
+    metrics.add("xmrig_hashes_total", MetricsWriter::COUNTER, "Pool-side hashes of accepted shares.");
+    metrics.sample("xmrig_hashes_total", m_hashes);
+
+    metrics.add("xmrig_pool_writes_total", MetricsWriter::COUNTER, "Socket writes to stratum pools.");
+    metrics.sample("xmrig_pool_writes_total", Client::writeStats().writes);
+
+    metrics.add("xmrig_pool_write_messages_total", MetricsWriter::COUNTER, "Stratum messages sent, several messages queued in the same event loop iteration share one write.");
+    metrics.sample("xmrig_pool_write_messages_total", Client::writeStats().messages);
+}
 #endif
 
 
@@ -259,11 +335,14 @@ void xmrig::NetworkState::onActive(IStrategy *strategy, IClient *client)
 {
     snprintf(m_pool, sizeof(m_pool) - 1, "%s:%d", client->pool().host().data(), client->pool().port());
 
-    m_ip             = client->ip();
-    m_tls            = client->tlsVersion();
-    m_fingerprint    = client->tlsFingerprint();
-    m_active         = true;
-    m_connectionTime = Chrono::steadyMSecs();
+    m_ip               = client->ip();
+    m_tls              = client->tlsVersion();
+    m_fingerprint      = client->tlsFingerprint();
+    m_tlsResumed       = client->isTLSResumed();
+    m_tlsResumption    = client->tlsResumption();
+    m_tlsHandshakeTime = client->tlsHandshakeTime();
+    m_active           = true;
+    m_connectionTime   = Chrono::steadyMSecs();
 
     StrategyProxy::onActive(strategy, client);
 }
@@ -273,6 +352,7 @@ void xmrig::NetworkState::onJob(IStrategy *strategy, IClient *client, const Job
 {
     m_algorithm = job.algorithm();
     m_diff      = job.diff();
+    m_jobs++;
 
     StrategyProxy::onJob(strategy, client, job, params);
 }
@@ -330,6 +410,11 @@ void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
 {
     if (error) {
         m_rejected++;
+
+        if (isStale(error)) {
+            m_stale++;
+        }
+
         return;
     }
 
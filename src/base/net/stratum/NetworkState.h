@@ -33,6 +33,9 @@
 namespace xmrig {
 
 
+class MetricsWriter;
+
+
 class NetworkState : public StrategyProxy
 {
 public:
@@ -45,6 +48,7 @@ public:
 #   ifdef XMRIG_FEATURE_API
     rapidjson::Value getConnection(rapidjson::Document &doc, int version) const;
     rapidjson::Value getResults(rapidjson::Document &doc, int version) const;
+    void getMetrics(MetricsWriter &metrics) const;
 #   endif
 
     void printConnection() const;
@@ -68,8 +72,10 @@ private:
 
     Algorithm m_algorithm;
     bool m_active               = false;
+    bool m_tlsResumed           = false;
     char m_pool[256]{};
     std::array<uint64_t, 10> m_topDiff { { } };
+    double m_tlsResumption      = 0.0;
     std::vector<uint16_t> m_latency;
     String m_fingerprint;
     String m_ip;
@@ -79,7 +85,10 @@ private:
     uint64_t m_diff             = 0;
     uint64_t m_failures         = 0;
     uint64_t m_hashes           = 0;
+    uint64_t m_jobs             = 0;
     uint64_t m_rejected         = 0;
+    uint64_t m_stale            = 0;
+    uint64_t m_tlsHandshakeTime = 0;
 };
 
 
@@ -28,6 +28,7 @@
 #include "base/io/log/Log.h"
 #include "base/kernel/interfaces/IJsonReader.h"
 #include "base/net/stratum/strategies/FailoverStrategy.h"
+#include "base/net/stratum/strategies/LatencyStrategy.h"
 #include "base/net/stratum/strategies/SinglePoolStrategy.h"
 #include "donate.h"
 
@@ -37,16 +38,25 @@
 #endif
 
 
+#ifdef _MSC_VER
+#   define strcasecmp  _stricmp
+#endif
+
+
 namespace xmrig {
 
 
 const char *Pools::kDonateLevel     = "donate-level";
 const char *Pools::kDonateOverProxy = "donate-over-proxy";
 const char *Pools::kPools           = "pools";
+const char *Pools::kPoolStrategy    = "pool-strategy";
 const char *Pools::kRetries         = "retries";
 const char *Pools::kRetryPause      = "retry-pause";
 
 
+static const char *strategyNames[] = { "failover", "latency" };
+
+
 } // namespace xmrig
 
 
@@ -62,7 +72,7 @@ xmrig::Pools::Pools() :
 
 bool xmrig::Pools::isEqual(const Pools &other) const
 {
-    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause) {
+    if (m_data.size() != other.m_data.size() || m_retries != other.m_retries || m_retryPause != other.m_retryPause || m_strategy != other.m_strategy) {
         return false;
     }
 
@@ -90,6 +100,17 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
         }
     }
 
+    if (m_strategy == STRATEGY_LATENCY) {
+        auto strategy = new LatencyStrategy(retryPause(), retries(), listener);
+        for (const Pool &pool : m_data) {
+            if (pool.isEnabled()) {
+                strategy->add(pool);
+            }
+        }
+
+        return strategy;
+    }
+
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
     for (const Pool &pool : m_data) {
         if (pool.isEnabled()) {
@@ -165,6 +186,7 @@ void xmrig::Pools::load(const IJsonReader &reader)
     setProxyDonate(reader.getInt(kDonateOverProxy, PROXY_DONATE_AUTO));
     setRetries(reader.getInt(kRetries));
     setRetryPause(reader.getInt(kRetryPause));
+    setStrategy(reader.getString(kPoolStrategy));
 }
 
 
@@ -213,6 +235,7 @@ void xmrig::Pools::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
     doc.AddMember(StringRef(kDonateLevel),      m_donateLevel, allocator);
     doc.AddMember(StringRef(kDonateOverProxy),  m_proxyDonate, allocator);
     out.AddMember(StringRef(kPools),            toJSON(doc), allocator);
+    doc.AddMember(StringRef(kPoolStrategy),     StringRef(strategyNames[m_strategy]), allocator);
     doc.AddMember(StringRef(kRetries),          retries(), allocator);
     doc.AddMember(StringRef(kRetryPause),       retryPause(), allocator);
 }
@@ -254,3 +277,19 @@ void xmrig::Pools::setRetryPause(int retryPause)
         m_retryPause = retryPause;
     }
 }
+
+
+void xmrig::Pools::setStrategy(const char *strategy)
+{
+    if (!strategy) {
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(strategyNames) / sizeof(strategyNames[0]); ++i) {
+        if (strcasecmp(strategy, strategyNames[i]) == 0) {
+            m_strategy = static_cast<Strategy>(i);
+
+            return;
+        }
+    }
+}
@@ -46,6 +46,7 @@ public:
     static const char *kDonateLevel;
     static const char *kDonateOverProxy;
     static const char *kPools;
+    static const char *kPoolStrategy;
     static const char *kRetries;
     static const char *kRetryPause;
 
@@ -55,10 +56,16 @@ public:
         PROXY_DONATE_ALWAYS
     };
 
+    enum Strategy {
+        STRATEGY_FAILOVER,
+        STRATEGY_LATENCY
+    };
+
     Pools();
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     inline bool isBenchmark() const                     { return !!m_benchmark; }
+    inline const std::shared_ptr<BenchConfig> &benchmark() const { return m_benchmark; }
 #   else
     inline constexpr static bool isBenchmark()          { return false; }
 #   endif
@@ -67,6 +74,7 @@ public:
     inline int retries() const                          { return m_retries; }
     inline int retryPause() const                       { return m_retryPause; }
     inline ProxyDonate proxyDonate() const              { return m_proxyDonate; }
+    inline Strategy strategy() const                    { return m_strategy; }
 
     inline bool operator!=(const Pools &other) const    { return !isEqual(other); }
     inline bool operator==(const Pools &other) const    { return isEqual(other); }
@@ -86,11 +94,13 @@ private:
     void setProxyDonate(int value);
     void setRetries(int retries);
     void setRetryPause(int retryPause);
+    void setStrategy(const char *strategy);
 
     int m_donateLevel;
     int m_retries               = 5;
     int m_retryPause            = 5;
     ProxyDonate m_proxyDonate   = PROXY_DONATE_AUTO;
+    Strategy m_strategy         = STRATEGY_FAILOVER;
     std::vector<Pool> m_data;
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
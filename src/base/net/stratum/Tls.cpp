@@ -20,6 +20,7 @@
 #include "base/net/stratum/Tls.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Client.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 
 
@@ -29,13 +30,128 @@
 
 
 #include <cassert>
+#include <map>
+#include <memory>
 #include <openssl/ssl.h>
+#include <string>
+
+
+namespace xmrig {
+
+
+// Process-wide client context for one pool address, shared by every connection to it (reconnects, failover
+// back to the pool, donate rounds). Keeps the last session or ticket the pool sent, so the next handshake
+// can be an abbreviated one. All clients run on the main loop, no locking is required.
+class TlsClientContext
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(TlsClientContext)
+
+    ~TlsClientContext()
+    {
+        if (m_session) {
+            SSL_SESSION_free(m_session);
+        }
+
+        SSL_CTX_free(m_ctx);
+    }
+
+
+    static TlsClientContext *get(const char *url)
+    {
+        auto &ctx = m_contexts[url];
+        if (!ctx) {
+            ctx.reset(new TlsClientContext());
+        }
+
+        return ctx->m_ctx ? ctx.get() : nullptr;
+    }
+
+
+    static inline void release() { m_contexts.clear(); }
+
+    inline double resumption() const { return m_handshakes ? static_cast<double>(m_resumed) / m_handshakes : 0.0; }
+
+
+    SSL *create() const
+    {
+        SSL *ssl = SSL_new(m_ctx);
+        if (ssl && m_session) {
+#           if OPENSSL_VERSION_NUMBER >= 0x10101000L
+            if (SSL_SESSION_is_resumable(m_session))
+#           endif
+            {
+                SSL_set_session(ssl, m_session);
+            }
+        }
+
+        return ssl;
+    }
+
+
+    void done(bool resumed)
+    {
+        m_handshakes++;
+
+        if (resumed) {
+            m_resumed++;
+        }
+    }
+
+
+private:
+    inline TlsClientContext() :
+        m_ctx(SSL_CTX_new(SSLv23_method()))
+    {
+        if (!m_ctx) {
+            return;
+        }
+
+        SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+        SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(m_ctx, onNewSession);
+        SSL_CTX_set_app_data(m_ctx, this);
+    }
+
+
+    static int onNewSession(SSL *ssl, SSL_SESSION *session)
+    {
+        auto ctx = static_cast<TlsClientContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        if (ctx->m_session) {
+            SSL_SESSION_free(ctx->m_session);
+        }
+
+        ctx->m_session = session;
+
+        return 1;
+    }
+
+
+    SSL_CTX *m_ctx;
+    SSL_SESSION *m_session  = nullptr;
+    uint64_t m_handshakes   = 0;
+    uint64_t m_resumed      = 0;
+
+    static std::map<std::string, std::unique_ptr<TlsClientContext> > m_contexts;
+};
+
+
+std::map<std::string, std::unique_ptr<TlsClientContext> > TlsClientContext::m_contexts;
+
+
+} // namespace xmrig
+
+
+void xmrig::Client::releaseTls()
+{
+    TlsClientContext::release();
+}
 
 
 xmrig::Client::Tls::Tls(Client *client) :
-    m_client(client)
+    m_client(client),
+    m_ctx(TlsClientContext::get(client->url()))
 {
-    m_ctx = SSL_CTX_new(SSLv23_method());
     assert(m_ctx != nullptr);
 
     if (!m_ctx) {
@@ -44,17 +160,18 @@ xmrig::Client::Tls::Tls(Client *client) :
 
     m_write = BIO_new(BIO_s_mem());
     m_read  = BIO_new(BIO_s_mem());
-    SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
 }
 
 
 xmrig::Client::Tls::~Tls()
 {
-    if (m_ctx) {
-        SSL_CTX_free(m_ctx);
-    }
-
     if (m_ssl) {
+        // Pools usually drop the connection without close_notify, OpenSSL would then mark the session as not
+        // resumable, keep it usable if the handshake was completed and verified and no TLS error occurred since.
+        if (m_ready && !m_failed) {
+            SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
+
         SSL_free(m_ssl);
     }
 }
@@ -62,13 +179,15 @@ xmrig::Client::Tls::~Tls()
 
 bool xmrig::Client::Tls::handshake()
 {
-    m_ssl = SSL_new(m_ctx);
+    m_ssl = m_ctx ? m_ctx->create() : nullptr;
     assert(m_ssl != nullptr);
 
     if (!m_ssl) {
         return false;
     }
 
+    m_handshakeTs = Chrono::steadyMSecs();
+
     SSL_set_connect_state(m_ssl);
     SSL_set_bio(m_ssl, m_read, m_write);
     SSL_do_handshake(m_ssl);
@@ -79,7 +198,13 @@ bool xmrig::Client::Tls::handshake()
 
 bool xmrig::Client::Tls::send(const char *data, size_t size)
 {
-    SSL_write(m_ssl, data, size);
+    const int rc = SSL_write(m_ssl, data, size);
+    if (rc <= 0) {
+        const int error = SSL_get_error(m_ssl, rc);
+        if (error == SSL_ERROR_SSL || error == SSL_ERROR_SYSCALL) {
+            m_failed = true;
+        }
+    }
 
     return send();
 }
@@ -97,6 +222,12 @@ const char *xmrig::Client::Tls::version() const
 }
 
 
+double xmrig::Client::Tls::resumption() const
+{
+    return m_ready ? m_ctx->resumption() : 0.0;
+}
+
+
 void xmrig::Client::Tls::read(const char *data, size_t size)
 {
     BIO_write(m_read, data, size);
@@ -116,8 +247,11 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
             }
 
             X509_free(cert);
-            m_ready = true;
-            m_client->login();
+            m_ready         = true;
+            m_resumed       = SSL_session_reused(m_ssl) == 1;
+            m_handshakeTime = Chrono::steadyMSecs() - m_handshakeTs;
+            m_ctx->done(m_resumed);
+            m_client->onHandshake();
       }
 
       return;
@@ -129,6 +263,11 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
     while ((bytes_read = SSL_read(m_ssl, buf, sizeof(buf))) > 0) {
         m_client->m_reader.parse(buf, static_cast<size_t>(bytes_read));
     }
+
+    const int error = SSL_get_error(m_ssl, bytes_read);
+    if (error == SSL_ERROR_SSL || error == SSL_ERROR_SYSCALL) {
+        m_failed = true;
+    }
 }
 
 
@@ -23,7 +23,6 @@
 
 using BIO       = struct bio_st;
 using SSL       = struct ssl_st;
-using SSL_CTX   = struct ssl_ctx_st;
 using X509      = struct x509_st;
 
 
@@ -34,6 +33,9 @@ using X509      = struct x509_st;
 namespace xmrig {
 
 
+class TlsClientContext;
+
+
 class Client::Tls
 {
 public:
@@ -42,10 +44,14 @@ public:
     Tls(Client *client);
     ~Tls();
 
+    inline bool isResumed() const           { return m_resumed; }
+    inline uint64_t handshakeTime() const   { return m_handshakeTime; }
+
     bool handshake();
     bool send(const char *data, size_t size);
     const char *fingerprint() const;
     const char *version() const;
+    double resumption() const;
     void read(const char *data, size_t size);
 
 private:
@@ -53,13 +59,17 @@ private:
     bool verify(X509 *cert);
     bool verifyFingerprint(X509 *cert);
 
-    BIO *m_read     = nullptr;
-    BIO *m_write    = nullptr;
-    bool m_ready    = false;
+    BIO *m_read                 = nullptr;
+    BIO *m_write                = nullptr;
+    bool m_failed               = false;
+    bool m_ready                = false;
+    bool m_resumed              = false;
     char m_fingerprint[32 * 2 + 8]{};
     Client *m_client;
-    SSL *m_ssl      = nullptr;
-    SSL_CTX *m_ctx;
+    SSL *m_ssl                  = nullptr;
+    TlsClientContext *m_ctx;
+    uint64_t m_handshakeTime    = 0;
+    uint64_t m_handshakeTs      = 0;
 };
 
 
@@ -41,17 +41,20 @@ public:
     inline bool hasExtension(Extension) const noexcept override                     { return false; }
     inline bool isEnabled() const override                                          { return true; }
     inline bool isTLS() const override                                              { return false; }
+    inline bool isTLSResumed() const override                                       { return false; }
     inline const char *mode() const override                                        { return "benchmark"; }
     inline const char *tlsFingerprint() const override                              { return nullptr; }
     inline const char *tlsVersion() const override                                  { return nullptr; }
     inline const Job &job() const override                                          { return m_job; }
     inline const Pool &pool() const override                                        { return m_pool; }
     inline const String &ip() const override                                        { return m_ip; }
+    inline double tlsResumption() const override                                    { return 0.0; }
     inline int id() const override                                                  { return 0; }
     inline int64_t send(const rapidjson::Value &, Callback) override                { return 0; }
     inline int64_t send(const rapidjson::Value &) override                          { return 0; }
     inline int64_t sequence() const override                                        { return 0; }
     inline int64_t submit(const JobResult &) override                               { return 0; }
+    inline uint64_t tlsHandshakeTime() const override                               { return 0; }
     inline void connect(const Pool &pool) override                                  { setPool(pool); }
     inline void deleteLater() override                                              { delete this; }
     inline void setAlgo(const Algorithm &algo) override                             {}
@@ -22,6 +22,7 @@
 #include "base/io/json/Json.h"
 
 
+#include <algorithm>
 #include <string>
 
 
@@ -41,10 +42,36 @@ const char *BenchConfig::kSeed      = "seed";
 const char *BenchConfig::kSize      = "size";
 const char *BenchConfig::kRotation  = "rotation";
 const char *BenchConfig::kSubmit    = "submit";
+const char *BenchConfig::kSweep     = "sweep";
 const char *BenchConfig::kToken     = "token";
 const char *BenchConfig::kUser      = "user";
 const char *BenchConfig::kVerify    = "verify";
 
+static const char *kHugePages      = "huge-pages";
+static const char *kIntensity      = "intensity";
+static const char *kInterpreter    = "interpreter";
+static const char *kReport         = "report";
+static const char *kRuns           = "runs";
+static const char *kThreads        = "threads";
+static const char *kWarmup         = "warmup";
+static const char *kDefaultReport  = "bench-sweep.json";
+
+
+static void readArray(const rapidjson::Value &value, std::vector<uint32_t> &out)
+{
+    if (value.IsUint()) {
+        out.push_back(value.GetUint());
+    }
+    else if (value.IsArray()) {
+        for (const auto &item : value.GetArray()) {
+            if (item.IsUint()) {
+                out.push_back(item.GetUint());
+            }
+        }
+    }
+}
+
+
 #ifndef XMRIG_DEBUG_BENCHMARK_API
 const char *BenchConfig::kApiHost   = "api.xmrig.com";
 #else
@@ -78,6 +105,8 @@ xmrig::BenchConfig::BenchConfig(uint32_t size, const String &id, const rapidjson
     if (hash) {
         m_hash = strtoull(hash, nullptr, 16);
     }
+
+    setSweep(object);
 }
 
 
@@ -93,11 +122,14 @@ xmrig::BenchConfig *xmrig::BenchConfig::create(const rapidjson::Value &object, b
     const char* rotation_str = Json::getString(object, kRotation);
     const uint32_t rotation = rotation_str ? strtoul(rotation_str, nullptr, 10) : 0;
 
-    if (size == 0 && id.isEmpty()) {
+    const auto &sweep       = Json::getValue(object, kSweep);
+    const bool isSweep      = sweep.IsString() || sweep.IsObject();
+
+    if (size == 0 && id.isEmpty() && !isSweep) {
         return nullptr;
     }
 
-    return new BenchConfig(size, id, object, dmi, rotation);
+    return new BenchConfig((size == 0 && isSweep) ? 1000000 : size, id, object, dmi, rotation);
 }
 
 
@@ -131,6 +163,10 @@ rapidjson::Value xmrig::BenchConfig::toJSON(rapidjson::Document &doc) const
         out.AddMember(StringRef(kHash), kNullType, allocator);
     }
 
+    if (isSweep()) {
+        out.AddMember(StringRef(kSweep), sweepToJSON(doc), allocator);
+    }
+
     return out;
 }
 
@@ -156,3 +192,111 @@ uint32_t xmrig::BenchConfig::getSize(const char *benchmark)
     return 0;
 #   endif
 }
+
+
+rapidjson::Value xmrig::BenchConfig::sweepToJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    Value out(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    Value algo(kArrayType);
+    for (const auto &algorithm : m_sweep.algorithms) {
+        algo.PushBack(algorithm.toJSON(), allocator);
+    }
+
+    Value threads(kArrayType);
+    for (const uint32_t value : m_sweep.threads) {
+        threads.PushBack(value, allocator);
+    }
+
+    Value intensity(kArrayType);
+    for (const uint32_t value : m_sweep.intensity) {
+        intensity.PushBack(value, allocator);
+    }
+
+    Value hugePages(kArrayType);
+    for (const bool value : m_sweep.hugePages) {
+        hugePages.PushBack(value, allocator);
+    }
+
+    Value interpreter(kArrayType);
+    for (const auto &value : m_sweep.interpreter) {
+        interpreter.PushBack(value.toJSON(), allocator);
+    }
+
+    out.AddMember(StringRef(kAlgo),         algo, allocator);
+    out.AddMember(StringRef(kThreads),      threads, allocator);
+    out.AddMember(StringRef(kIntensity),    intensity, allocator);
+    out.AddMember(StringRef(kHugePages),    hugePages, allocator);
+    out.AddMember(StringRef(kInterpreter),  interpreter, allocator);
+    out.AddMember(StringRef(kWarmup),       m_sweep.warmup, allocator);
+    out.AddMember(StringRef(kRuns),         m_sweep.runs, allocator);
+    out.AddMember(StringRef(kReport),       m_sweep.report.toJSON(), allocator);
+
+    return out;
+}
+
+
+void xmrig::BenchConfig::setSweep(const rapidjson::Value &object)
+{
+    const auto &value = Json::getValue(object, kSweep);
+
+    if (value.IsString()) {
+        m_sweep.report = value.GetString();
+    }
+    else if (value.IsObject()) {
+        m_sweep.report = Json::getString(value, kReport, kDefaultReport);
+        m_sweep.runs   = std::max(Json::getUint(value, kRuns, m_sweep.runs), 1U);
+        m_sweep.warmup = Json::getUint(value, kWarmup, m_sweep.warmup);
+
+        const auto &algo = Json::getValue(value, kAlgo);
+        if (algo.IsString()) {
+            m_sweep.algorithms.emplace_back(algo.GetString());
+        }
+        else if (algo.IsArray()) {
+            for (const auto &item : algo.GetArray()) {
+                m_sweep.algorithms.emplace_back(item);
+            }
+        }
+
+        const auto &hugePages = Json::getValue(value, kHugePages);
+        if (hugePages.IsBool()) {
+            m_sweep.hugePages.push_back(hugePages.GetBool());
+        }
+        else if (hugePages.IsArray()) {
+            for (const auto &item : hugePages.GetArray()) {
+                if (item.IsBool()) {
+                    m_sweep.hugePages.push_back(item.GetBool());
+                }
+            }
+        }
+
+        const auto &interpreter = Json::getValue(value, kInterpreter);
+        if (interpreter.IsString()) {
+            m_sweep.interpreter.emplace_back(interpreter.GetString());
+        }
+        else if (interpreter.IsArray()) {
+            for (const auto &item : interpreter.GetArray()) {
+                if (item.IsString()) {
+                    m_sweep.interpreter.emplace_back(item.GetString());
+                }
+            }
+        }
+
+        readArray(Json::getValue(value, kThreads), m_sweep.threads);
+        readArray(Json::getValue(value, kIntensity), m_sweep.intensity);
+    }
+    else {
+        return;
+    }
+
+    m_sweep.algorithms.erase(std::remove_if(m_sweep.algorithms.begin(), m_sweep.algorithms.end(), [](const Algorithm &algorithm) { return !algorithm.isValid(); }), m_sweep.algorithms.end());
+
+    // Unlike the regular benchmark the sweep is not limited to RandomX and GhostRider.
+    if (m_sweep.algorithms.empty()) {
+        const Algorithm algorithm(Json::getString(object, kAlgo));
+
+        m_sweep.algorithms.push_back(algorithm.isValid() ? algorithm : m_algorithm);
+    }
+}
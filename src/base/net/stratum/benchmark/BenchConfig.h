@@ -24,6 +24,9 @@
 #include "base/tools/String.h"
 
 
+#include <vector>
+
+
 namespace xmrig {
 
 
@@ -39,6 +42,7 @@ public:
     static const char *kSize;
     static const char* kRotation;
     static const char *kSubmit;
+    static const char *kSweep;
     static const char *kToken;
     static const char *kUser;
     static const char *kVerify;
@@ -51,17 +55,31 @@ public:
     static constexpr const uint16_t kApiPort    = 18805;
 #   endif
 
+    struct Sweep
+    {
+        std::vector<Algorithm> algorithms;
+        std::vector<bool> hugePages;
+        std::vector<String> interpreter;
+        std::vector<uint32_t> intensity;
+        std::vector<uint32_t> threads;
+        String report;
+        uint32_t runs       = 3;
+        uint32_t warmup     = 1;
+    };
+
     BenchConfig(uint32_t size, const String &id, const rapidjson::Value &object, bool dmi, uint32_t rotation);
 
     static BenchConfig *create(const rapidjson::Value &object, bool dmi);
 
     inline bool isDMI() const                   { return m_dmi; }
     inline bool isSubmit() const                { return m_submit; }
+    inline bool isSweep() const                 { return !m_sweep.report.isEmpty(); }
     inline const Algorithm &algorithm() const   { return m_algorithm; }
     inline const String &id() const             { return m_id; }
     inline const String &seed() const           { return m_seed; }
     inline const String &token() const          { return m_token; }
     inline const String &user() const           { return m_user; }
+    inline const Sweep &sweep() const           { return m_sweep; }
     inline uint32_t size() const                { return m_size; }
     inline uint64_t hash() const                { return m_hash; }
     inline uint32_t rotation() const            { return m_rotation; }
@@ -71,6 +89,9 @@ public:
 private:
     static uint32_t getSize(const char *benchmark);
 
+    rapidjson::Value sweepToJSON(rapidjson::Document &doc) const;
+    void setSweep(const rapidjson::Value &object);
+
     Algorithm m_algorithm;
     bool m_dmi;
     bool m_submit;
@@ -78,6 +99,7 @@ private:
     String m_seed;
     String m_token;
     String m_user;
+    Sweep m_sweep;
     uint32_t m_size;
     uint32_t m_rotation;
     uint64_t m_hash = 0;
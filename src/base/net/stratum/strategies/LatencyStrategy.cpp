@@ -0,0 +1,351 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/net/stratum/strategies/LatencyStrategy.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/interfaces/IClient.h"
+#include "base/kernel/interfaces/IStrategyListener.h"
+#include "base/net/stratum/Job.h"
+#include "base/net/stratum/SubmitResult.h"
+#include "base/tools/Chrono.h"
+
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace xmrig {
+
+
+static constexpr double kSmoothing          = 0.2;
+static constexpr double kRejectPenalty      = 1000.0;
+static constexpr double kMinGain            = 20.0;
+static constexpr double kMinGainRatio       = 0.15;
+static constexpr uint64_t kEvaluateInterval = 10 * 1000;
+static constexpr uint64_t kMinHoldTime      = 60 * 1000;
+static constexpr uint64_t kMaxJobDelay      = 120 * 1000;
+
+
+static inline void smooth(double &value, double sample)
+{
+    value = value < 0.0 ? sample : (value * (1.0 - kSmoothing) + sample * kSmoothing);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::LatencyStrategy::LatencyStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet) :
+    m_quiet(quiet),
+    m_retries(retries),
+    m_retryPause(retryPause),
+    m_listener(listener)
+{
+}
+
+
+xmrig::LatencyStrategy::~LatencyStrategy()
+{
+    for (auto &entry : m_pools) {
+        entry.client->deleteLater();
+    }
+}
+
+
+void xmrig::LatencyStrategy::add(const Pool &pool)
+{
+    IClient *client = pool.createClient(static_cast<int>(m_pools.size()), this);
+
+    client->setRetries(m_retries);
+    client->setRetryPause(m_retryPause * 1000);
+    client->setQuiet(m_quiet);
+
+    m_pools.emplace_back(client);
+}
+
+
+int64_t xmrig::LatencyStrategy::submit(const JobResult &result)
+{
+    if (!isActive()) {
+        return -1;
+    }
+
+    return active()->submit(result);
+}
+
+
+void xmrig::LatencyStrategy::connect()
+{
+    for (auto &entry : m_pools) {
+        entry.client->connect();
+    }
+}
+
+
+void xmrig::LatencyStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(this, active(), active()->job(), rapidjson::Value(rapidjson::kNullType));
+}
+
+
+void xmrig::LatencyStrategy::setAlgo(const Algorithm &algo)
+{
+    for (auto &entry : m_pools) {
+        entry.client->setAlgo(algo);
+    }
+}
+
+
+void xmrig::LatencyStrategy::setProxy(const ProxyUrl &proxy)
+{
+    for (auto &entry : m_pools) {
+        entry.client->setProxy(proxy);
+    }
+}
+
+
+void xmrig::LatencyStrategy::stop()
+{
+    for (auto &entry : m_pools) {
+        entry.ready = false;
+        entry.client->disconnect();
+    }
+
+    m_active = -1;
+
+    m_listener->onPause(this);
+}
+
+
+void xmrig::LatencyStrategy::tick(uint64_t now)
+{
+    for (auto &entry : m_pools) {
+        entry.client->tick(now);
+    }
+
+    if (!isActive() || now < m_nextEvaluate) {
+        return;
+    }
+
+    m_nextEvaluate = now + kEvaluateInterval;
+
+    if (now - m_switchTime < kMinHoldTime) {
+        return;
+    }
+
+    const int index = best();
+    if (index < 0 || index == m_active) {
+        return;
+    }
+
+    const double fallback = fallbackLatency();
+    const double current  = m_pools[static_cast<size_t>(m_active)].score(fallback);
+    const double score    = m_pools[static_cast<size_t>(index)].score(fallback);
+
+    if (current - score > std::max(kMinGain, current * kMinGainRatio)) {
+        LOG_INFO("%s " WHITE_BOLD("switching to ") CYAN_BOLD("%s:%d") WHITE_BOLD(", score ") CYAN_BOLD("%.0f") WHITE_BOLD(" vs ") CYAN_BOLD("%.0f"),
+                 Tags::network(), m_pools[static_cast<size_t>(index)].client->pool().host().data(), m_pools[static_cast<size_t>(index)].client->pool().port(), score, current);
+
+        setActive(index, true);
+    }
+}
+
+
+void xmrig::LatencyStrategy::toJSON(rapidjson::Value &out, rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    const double fallback = fallbackLatency();
+
+    Value pools(kArrayType);
+    pools.Reserve(static_cast<SizeType>(m_pools.size()), allocator);
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        const auto &entry = m_pools[i];
+
+        Value pool(kObjectType);
+        pool.AddMember("url",       entry.client->pool().url().toJSON(), allocator);
+        pool.AddMember("ready",     entry.ready, allocator);
+        pool.AddMember("active",    m_active == static_cast<int>(i), allocator);
+        pool.AddMember("latency",   entry.latency < 0.0 ? Value(kNullType) : Value(static_cast<int64_t>(std::lround(entry.latency))), allocator);
+        pool.AddMember("job_delay", entry.jobDelay < 0.0 ? Value(kNullType) : Value(static_cast<int64_t>(std::lround(entry.jobDelay))), allocator);
+        pool.AddMember("accepted",  entry.accepted, allocator);
+        pool.AddMember("rejected",  entry.rejected, allocator);
+        pool.AddMember("score",     entry.ready ? Value(static_cast<int64_t>(std::lround(entry.score(fallback)))) : Value(kNullType), allocator);
+
+        pools.PushBack(pool, allocator);
+    }
+
+    out.AddMember("strategy", "latency", allocator);
+    out.AddMember("pools", pools, allocator);
+}
+
+
+void xmrig::LatencyStrategy::onClose(IClient *client, int failures)
+{
+    auto &entry  = m_pools[static_cast<size_t>(client->id())];
+    entry.ready  = false;
+    entry.height = 0;
+
+    if (failures == -1) {
+        return;
+    }
+
+    if (m_active == client->id()) {
+        m_active = -1;
+        m_listener->onPause(this);
+
+        const int index = best();
+        if (index >= 0) {
+            setActive(index, true);
+        }
+    }
+}
+
+
+void xmrig::LatencyStrategy::onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params)
+{
+    auto &entry = m_pools[static_cast<size_t>(client->id())];
+
+    if (job.height() && job.height() != entry.height) {
+        const uint64_t now = Chrono::steadyMSecs();
+
+        if (job.height() > m_height) {
+            m_height     = job.height();
+            m_heightTime = now;
+        }
+
+        // Only a new block seen on an established connection is a delay sample, the first job after login
+        // and pools on another chain are not.
+        if (entry.height && job.height() == m_height && now - m_heightTime < kMaxJobDelay) {
+            smooth(entry.jobDelay, static_cast<double>(now - m_heightTime));
+        }
+
+        entry.height = job.height();
+    }
+
+    if (m_active == client->id()) {
+        m_listener->onJob(this, client, job, params);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params)
+{
+    m_listener->onLogin(this, client, doc, params);
+}
+
+
+void xmrig::LatencyStrategy::onLoginSuccess(IClient *client)
+{
+    m_pools[static_cast<size_t>(client->id())].ready = true;
+
+    if (!isActive()) {
+        setActive(client->id(), false);
+    }
+}
+
+
+void xmrig::LatencyStrategy::onResultAccepted(IClient *client, const SubmitResult &result, const char *error)
+{
+    auto &entry = m_pools[static_cast<size_t>(client->id())];
+
+    if (error) {
+        entry.rejected++;
+    }
+    else {
+        entry.accepted++;
+    }
+
+    smooth(entry.latency, static_cast<double>(result.elapsed));
+
+    m_listener->onResultAccepted(this, client, result, error);
+}
+
+
+void xmrig::LatencyStrategy::onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok)
+{
+    m_listener->onVerifyAlgorithm(this, client, algorithm, ok);
+}
+
+
+double xmrig::LatencyStrategy::Entry::score(double fallbackLatency) const
+{
+    const uint64_t total = accepted + rejected;
+
+    return (latency < 0.0 ? fallbackLatency : latency)
+         + (jobDelay < 0.0 ? 0.0 : jobDelay)
+         + (total ? kRejectPenalty * static_cast<double>(rejected) / static_cast<double>(total) : 0.0);
+}
+
+
+double xmrig::LatencyStrategy::fallbackLatency() const
+{
+    // Pools that never received a share are assumed to be as fast as the active one,
+    // so the decision between them falls back to job arrival delay.
+    if (isActive() && m_pools[static_cast<size_t>(m_active)].latency >= 0.0) {
+        return m_pools[static_cast<size_t>(m_active)].latency;
+    }
+
+    return 0.0;
+}
+
+
+int xmrig::LatencyStrategy::best() const
+{
+    const double fallback = fallbackLatency();
+    double score          = 0.0;
+    int index             = -1;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (!m_pools[i].ready) {
+            continue;
+        }
+
+        const double value = m_pools[i].score(fallback);
+        if (index < 0 || value < score) {
+            score = value;
+            index = static_cast<int>(i);
+        }
+    }
+
+    return index;
+}
+
+
+void xmrig::LatencyStrategy::setActive(int index, bool resume)
+{
+    IClient *client = m_pools[static_cast<size_t>(index)].client;
+
+    m_active     = index;
+    m_switchTime = Chrono::steadyMSecs();
+
+    m_listener->onActive(this, client);
+
+    if (resume && client->job().isValid()) {
+        m_listener->onJob(this, client, client->job(), rapidjson::Value(rapidjson::kNullType));
+    }
+}
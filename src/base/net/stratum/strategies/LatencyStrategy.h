@@ -0,0 +1,113 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_LATENCYSTRATEGY_H
+#define XMRIG_LATENCYSTRATEGY_H
+
+
+#include <vector>
+
+
+#include "base/kernel/interfaces/IClientListener.h"
+#include "base/kernel/interfaces/IStrategy.h"
+#include "base/net/stratum/Pool.h"
+#include "base/tools/Object.h"
+
+
+namespace xmrig {
+
+
+class IStrategyListener;
+
+
+/**
+ * Keeps all enabled pools connected and mines on the one with the lowest score.
+ *
+ * The score is an estimate in milliseconds of how late our work reaches the pool:
+ * smoothed share round-trip time plus how far behind the fastest pool new jobs arrive,
+ * plus a penalty proportional to the reject ratio. Switching requires a minimum gain and
+ * a minimum time on the current pool to avoid flapping.
+ */
+class LatencyStrategy : public IStrategy, public IClientListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(LatencyStrategy)
+
+    LatencyStrategy(int retryPause, int retries, IStrategyListener *listener, bool quiet = false);
+    ~LatencyStrategy() override;
+
+    void add(const Pool &pool);
+
+protected:
+    inline bool isActive() const override           { return m_active >= 0; }
+    inline IClient *client() const override         { return isActive() ? active() : m_pools.front().client; }
+
+    int64_t submit(const JobResult &result) override;
+    void connect() override;
+    void resume() override;
+    void setAlgo(const Algorithm &algo) override;
+    void setProxy(const ProxyUrl &proxy) override;
+    void stop() override;
+    void tick(uint64_t now) override;
+    void toJSON(rapidjson::Value &out, rapidjson::Document &doc) const override;
+
+    void onClose(IClient *client, int failures) override;
+    void onJobReceived(IClient *client, const Job &job, const rapidjson::Value &params) override;
+    void onLogin(IClient *client, rapidjson::Document &doc, rapidjson::Value &params) override;
+    void onLoginSuccess(IClient *client) override;
+    void onResultAccepted(IClient *client, const SubmitResult &result, const char *error) override;
+    void onVerifyAlgorithm(const IClient *client, const Algorithm &algorithm, bool *ok) override;
+
+private:
+    struct Entry
+    {
+        inline explicit Entry(IClient *client) : client(client) {}
+
+        double score(double fallbackLatency) const;
+
+        bool ready          = false;
+        double jobDelay     = -1.0;
+        double latency      = -1.0;
+        IClient *client;
+        uint64_t accepted   = 0;
+        uint64_t height     = 0;
+        uint64_t rejected   = 0;
+    };
+
+    inline IClient *active() const { return m_pools[static_cast<size_t>(m_active)].client; }
+
+    double fallbackLatency() const;
+    int best() const;
+    void setActive(int index, bool resume);
+
+    const bool m_quiet;
+    const int m_retries;
+    const int m_retryPause;
+    int m_active                = -1;
+    IStrategyListener *m_listener;
+    std::vector<Entry> m_pools;
+    uint64_t m_height           = 0;
+    uint64_t m_heightTime       = 0;
+    uint64_t m_nextEvaluate     = 0;
+    uint64_t m_switchTime       = 0;
+};
+
+
+} /* namespace xmrig */
+
+#endif /* XMRIG_LATENCYSTRATEGY_H */
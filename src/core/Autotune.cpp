@@ -0,0 +1,375 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/Autotune.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/RxConfig.h"
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+
+
+namespace xmrig {
+
+
+static const char *kBlob        = "9905A0DBD6BF05CF16E503F3A66F78007CBF34144332ECBFC22ED95C8700383B309ACE1923A0964B00000008BA939A62724C0D7581FCE5761E9D8A0E6A1C3F924FDD8493D1115649C05EB601";
+static const char *kClientId    = "autotune";
+static const char *kSeedHash    = "0000000000000000000000000000000000000000000000000000000000000001";
+static const char *kTarget      = "0100000000000000";   // never produces shares
+
+
+static bool isCn(const Algorithm &algorithm)
+{
+    switch (algorithm.family()) {
+    case Algorithm::CN:
+    case Algorithm::CN_LITE:
+    case Algorithm::CN_HEAVY:
+    case Algorithm::CN_PICO:
+    case Algorithm::CN_FEMTO:
+        return true;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+
+static void add(std::vector<CpuThreads> &out, CpuThreads &&threads)
+{
+    if (threads.isEmpty() || std::find(out.begin(), out.end(), threads) != out.end()) {
+        return;
+    }
+
+    out.emplace_back(std::move(threads));
+}
+
+
+static std::vector<CpuThreads> candidates(const Algorithm &algorithm, const CpuThreads &base)
+{
+    const auto info     = Cpu::info();
+    const auto &data    = base.data();
+    const size_t count  = data.size();
+
+    std::vector<CpuThreads> out;
+    out.emplace_back(base);
+
+    // Fewer threads per L3 cache.
+    for (size_t n : { count - 1, count * 3 / 4 }) {
+        CpuThreads threads;
+        for (size_t i = 0; i < n; ++i) {
+            threads.add(data[i]);
+        }
+
+        add(out, std::move(threads));
+    }
+
+    // One thread per core, generated layouts keep SMT siblings next to each other.
+    if (info->threads() > info->cores() && count > info->cores()) {
+        const size_t stride = info->threads() / info->cores();
+
+        CpuThreads threads;
+        for (size_t i = 0; i < count; i += stride) {
+            threads.add(data[i]);
+        }
+
+        add(out, std::move(threads));
+    }
+
+    // Every logical CPU.
+    if (count < info->threads()) {
+        CpuThreads threads = base;
+        const uint32_t intensity = data[0].intensity();
+
+        if (data[0].affinity() < 0) {
+            for (size_t i = count; i < info->threads(); ++i) {
+                threads.add(-1, intensity);
+            }
+        }
+        else {
+            for (int32_t unit : info->units()) {
+                if (std::none_of(data.begin(), data.end(), [unit](const CpuThread &thread) { return thread.affinity() == unit; })) {
+                    threads.add(unit, intensity);
+                }
+            }
+        }
+
+        add(out, std::move(threads));
+    }
+
+    // Hashes per thread (multi-way AV) for CryptoNight.
+    if (isCn(algorithm)) {
+        for (int delta : { 1, -1 }) {
+            CpuThreads threads;
+
+            for (const auto &thread : data) {
+                const int intensity = static_cast<int>(thread.intensity()) + delta;
+                if (intensity < 1 || intensity > 5) {
+                    threads = CpuThreads();
+                    break;
+                }
+
+                threads.add(thread.affinity(), static_cast<uint32_t>(intensity));
+            }
+
+            add(out, std::move(threads));
+        }
+    }
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Autotune::Autotune(Controller *controller, Callback callback) :
+    m_callback(std::move(callback)),
+    m_controller(controller)
+{
+    const auto &cpu = controller->config()->cpu();
+
+    for (const Algorithm &algorithm : controller->miner()->algorithms()) {
+        if (algorithm.family() == Algorithm::GHOSTRIDER || algorithm.family() == Algorithm::KAWPOW) {
+            continue;
+        }
+
+        const String profile = cpu.threads().profileName(algorithm);
+        if (profile.isNull() || cpu.threads().get(profile).isEmpty()) {
+            continue;
+        }
+
+        if (std::none_of(m_tasks.begin(), m_tasks.end(), [&profile](const Task &task) { return task.profile == profile; })) {
+            m_tasks.push_back({ algorithm, profile });
+        }
+    }
+}
+
+
+xmrig::Autotune::~Autotune()
+{
+    delete m_timer;
+    delete m_job;
+}
+
+
+void xmrig::Autotune::start()
+{
+    LOG_INFO("%s " WHITE_BOLD("autotune ") CYAN_BOLD("%zu") WHITE_BOLD(" profiles") BLACK_BOLD(" (%d s per trial)"),
+             Tags::cpu(), m_tasks.size(), m_controller->config()->benchAlgoTime());
+
+    m_timer = new Timer(this);
+    m_timer->start(kTick, kTick);
+
+    nextTask();
+}
+
+
+void xmrig::Autotune::onTimer(const Timer *)
+{
+    const uint64_t now  = Chrono::steadyMSecs();
+    const Hashrate *hr  = hashrate();
+
+    if (m_state == StateWarmup) {
+        if (hr && hr->calc(1000) > 0.0 && now - m_ts >= kWarmup) {
+            m_state = StateMeasure;
+            m_ts    = now;
+        }
+        else if (now - m_ts > kStartTimeout) {
+            LOG_WARN("%s " YELLOW("autotune trial %zu/%zu did not start"), Tags::cpu(), m_trial + 1, m_trials.size());
+
+            next();
+        }
+
+        return;
+    }
+
+    const uint64_t duration = static_cast<uint64_t>(std::max(m_controller->config()->benchAlgoTime(), 1)) * 1000;
+    if (now - m_ts < duration) {
+        return;
+    }
+
+    const double value = hr ? hr->calc(duration) : 0.0;
+    const auto &trial  = m_trials[m_trial];
+
+    LOG_INFO("%s " WHITE_BOLD("autotune %s") " trial %zu/%zu threads " CYAN_BOLD("%zu") " intensity " CYAN_BOLD("%u") " prefetch " CYAN_BOLD("%d") " speed " CYAN_BOLD("%.1f H/s"),
+             Tags::cpu(), m_tasks[m_task].profile.data(), m_trial + 1, m_trials.size(), trial.threads.count(), trial.threads.data()[0].intensity(), trial.prefetch, value);
+
+    if (m_trial == 0 || value > m_best * kThreshold) {
+        m_best      = value;
+        m_bestTrial = m_trial;
+    }
+
+    next();
+}
+
+
+const xmrig::Hashrate *xmrig::Autotune::hashrate() const
+{
+    for (IBackend *backend : m_controller->miner()->backends()) {
+        if (backend->type() == "cpu") {
+            return backend->hashrate();
+        }
+    }
+
+    return nullptr;
+}
+
+
+void xmrig::Autotune::finish()
+{
+    m_timer->stop();
+
+    m_controller->config()->cpu().setAutotune(false);
+    m_controller->miner()->pause();
+
+    if (!m_controller->config()->isAutoSave()) {
+        LOG_WARN("%s " YELLOW("autotune results will not be saved, \"autosave\" is disabled"), Tags::cpu());
+    }
+
+    m_callback();
+}
+
+
+void xmrig::Autotune::next()
+{
+    ++m_trial;
+
+    if (m_trial < m_trials.size()) {
+        return run();
+    }
+
+    const Task &task = m_tasks[m_task];
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const auto &rx = m_controller->config()->rx();
+
+    if (!m_prefetch && task.algorithm.family() == Algorithm::RANDOM_X) {
+        m_prefetch = true;
+
+        const CpuThreads best = m_trials[m_bestTrial].threads;
+
+        for (uint32_t mode = RxConfig::ScratchpadPrefetchOff; mode < RxConfig::ScratchpadPrefetchMax; ++mode) {
+            if (mode != rx.scratchpadPrefetchMode()) {
+                Trial trial;
+                trial.threads  = best;
+                trial.prefetch = static_cast<int>(mode);
+
+                m_trials.emplace_back(std::move(trial));
+            }
+        }
+
+        if (m_trial < m_trials.size()) {
+            return run();
+        }
+    }
+#   endif
+
+    const Trial &best = m_trials[m_bestTrial];
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (best.prefetch >= 0) {
+        m_controller->config()->rx().setScratchpadPrefetchMode(static_cast<RxConfig::ScratchpadPrefetchMode>(best.prefetch));
+    }
+
+    randomx_set_scratchpad_prefetch_mode(rx.scratchpadPrefetchMode());
+#   endif
+
+    LOG_INFO("%s " WHITE_BOLD("autotune %s") " selected trial " CYAN_BOLD("%zu") " threads " CYAN_BOLD("%zu") " speed " CYAN_BOLD("%.1f H/s"),
+             Tags::cpu(), task.profile.data(), m_bestTrial + 1, best.threads.count(), m_best);
+
+    CpuThreads threads = best.threads;
+    m_controller->config()->cpu().setThreads(task.profile, std::move(threads));
+
+    ++m_task;
+    nextTask();
+}
+
+
+void xmrig::Autotune::nextTask()
+{
+    if (m_task >= m_tasks.size()) {
+        return finish();
+    }
+
+    const Task &task = m_tasks[m_task];
+
+    m_trials.clear();
+    for (auto &threads : candidates(task.algorithm, m_controller->config()->cpu().threads().get(task.profile))) {
+        Trial trial;
+        trial.threads = std::move(threads);
+
+        m_trials.emplace_back(std::move(trial));
+    }
+
+    m_best      = 0.0;
+    m_bestTrial = 0;
+    m_trial     = 0;
+
+    delete m_job;
+    m_job = new Job(false, task.algorithm, kClientId);
+    m_job->setBlob(kBlob);
+    m_job->setTarget(kTarget);
+    m_job->setHeight(1000);
+    m_job->setSeedHash(kSeedHash);
+
+    LOG_INFO("%s " WHITE_BOLD("autotune %s") " (%s) " CYAN_BOLD("%zu") " candidates", Tags::cpu(), task.profile.data(), task.algorithm.name(), m_trials.size());
+
+    run();
+}
+
+
+void xmrig::Autotune::run()
+{
+    const Trial &trial = m_trials[m_trial];
+
+    CpuThreads threads = trial.threads;
+    m_controller->config()->cpu().setThreads(m_tasks[m_task].profile, std::move(threads));
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (trial.prefetch >= 0) {
+        randomx_set_scratchpad_prefetch_mode(trial.prefetch);
+    }
+#   endif
+
+    char id[32];
+    snprintf(id, sizeof(id), "%s%u", kClientId, ++m_sequence);
+
+    m_job->setId(id);
+    m_controller->miner()->setJob(*m_job, false);
+
+    m_state = StateWarmup;
+    m_ts    = Chrono::steadyMSecs();
+}
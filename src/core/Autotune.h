@@ -0,0 +1,115 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_AUTOTUNE_H
+#define XMRIG_AUTOTUNE_H
+
+
+#include "backend/cpu/CpuThreads.h"
+#include "base/crypto/Algorithm.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <functional>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Controller;
+class Hashrate;
+class Job;
+class Timer;
+
+
+/**
+ * Opt-in CPU autotuner ("cpu": {"autotune": true}).
+ *
+ * For every CPU profile used by an enabled algorithm it runs short timed
+ * trials of candidate thread layouts on a local job, keeps the fastest one
+ * and stores it in the profile, then disables itself so the saved config
+ * is used as is on the next start.
+ */
+class Autotune : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Autotune)
+
+    using Callback = std::function<void()>;
+
+    constexpr static uint64_t kTick         = 500;
+    constexpr static uint64_t kWarmup       = 3000;
+    constexpr static uint64_t kStartTimeout = 5 * 60 * 1000;
+    constexpr static double kThreshold      = 1.01;
+
+    Autotune(Controller *controller, Callback callback);
+    ~Autotune() override;
+
+    void start();
+
+protected:
+    void onTimer(const Timer *timer) override;
+
+private:
+    enum State {
+        StateWarmup,
+        StateMeasure
+    };
+
+    struct Task
+    {
+        Algorithm algorithm;
+        String profile;
+    };
+
+    struct Trial
+    {
+        CpuThreads threads;
+        int prefetch = -1;
+    };
+
+    const Hashrate *hashrate() const;
+    void finish();
+    void next();
+    void nextTask();
+    void run();
+
+    bool m_prefetch         = false;
+    Callback m_callback;
+    Controller *m_controller;
+    double m_best           = 0.0;
+    Job *m_job              = nullptr;
+    size_t m_bestTrial      = 0;
+    size_t m_task           = 0;
+    size_t m_trial          = 0;
+    State m_state           = StateWarmup;
+    std::vector<Task> m_tasks;
+    std::vector<Trial> m_trials;
+    Timer *m_timer          = nullptr;
+    uint32_t m_sequence     = 0;
+    uint64_t m_ts           = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_AUTOTUNE_H
@@ -0,0 +1,563 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/BenchSweep.h"
+#include "3rdparty/fmt/core.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/common/benchmark/BenchState.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/stratum/benchmark/BenchConfig.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
+#include "core/config/Config.h"
+#include "core/Controller.h"
+#include "core/Miner.h"
+#include "version.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/Rx.h"
+#   include "crypto/rx/RxConfig.h"
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+
+
+namespace xmrig {
+
+
+static const char *kClientId = "sweep";
+
+
+static bool isValidIntensity(const Algorithm &algorithm, uint32_t intensity)
+{
+    switch (algorithm.family()) {
+    case Algorithm::ARGON2:
+        return intensity == 1 || intensity == 2 || intensity == 4;
+
+    case Algorithm::CN:
+    case Algorithm::CN_LITE:
+    case Algorithm::CN_HEAVY:
+    case Algorithm::CN_PICO:
+    case Algorithm::CN_FEMTO:
+        return intensity >= 1 && intensity <= 5;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+
+static bool isFixedIntensity(const Algorithm &algorithm)
+{
+    return algorithm.family() == Algorithm::RANDOM_X || algorithm.family() == Algorithm::GHOSTRIDER;
+}
+
+
+static void stats(const std::vector<double> &samples, double &mean, double &stddev)
+{
+    mean   = 0.0;
+    stddev = 0.0;
+
+    if (samples.empty()) {
+        return;
+    }
+
+    for (double value : samples) {
+        mean += value;
+    }
+
+    mean /= samples.size();
+
+    if (samples.size() < 2) {
+        return;
+    }
+
+    for (double value : samples) {
+        stddev += (value - mean) * (value - mean);
+    }
+
+    stddev = std::sqrt(stddev / (samples.size() - 1));
+}
+
+
+static rapidjson::Value toJSON(const HugePagesInfo &info, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    Value out(kArrayType);
+    out.PushBack(static_cast<uint64_t>(info.allocated), doc.GetAllocator());
+    out.PushBack(static_cast<uint64_t>(info.total), doc.GetAllocator());
+
+    return out;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::BenchSweep::BenchSweep(Controller *controller, const std::shared_ptr<BenchConfig> &benchmark) :
+    m_benchmark(benchmark),
+    m_controller(controller)
+{
+    const auto &sweep   = benchmark->sweep();
+    const auto &cpu     = controller->config()->cpu();
+    m_hugePages         = cpu.isHugePages();
+
+    const std::vector<bool> hugePages       = sweep.hugePages.empty() ? std::vector<bool>{ m_hugePages } : sweep.hugePages;
+    const std::vector<uint32_t> threads     = sweep.threads.empty() ? std::vector<uint32_t>{ 0 } : sweep.threads;
+
+    std::vector<String> interpreters;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    m_interpreter = controller->config()->rx().interpreter();
+
+    for (const String &name : sweep.interpreter) {
+        if (RxConfig::interpreter(name) != RxConfig::InterpreterMax) {
+            interpreters.push_back(name);
+        }
+        else {
+            LOG_WARN("%s " YELLOW("sweep skips unknown interpreter ") WHITE_BOLD("\"%s\""), Tags::bench(), name.data());
+        }
+    }
+
+    if (interpreters.empty()) {
+        interpreters.emplace_back(controller->config()->rx().interpreterName());
+    }
+#   endif
+
+    for (const Algorithm &algorithm : sweep.algorithms) {
+        const String profile = cpu.threads().profileName(algorithm);
+
+        // apply() takes affinity and intensity from the profile threads, a profile without threads cannot be swept.
+        if (algorithm.family() == Algorithm::KAWPOW || profile.isNull() || cpu.threads().get(profile).isEmpty() || !controller->miner()->isEnabled(algorithm)) {
+            LOG_WARN("%s " YELLOW("sweep skips ") WHITE_BOLD("%s") YELLOW(" (no suitable CPU configuration found)"), Tags::bench(), algorithm.name());
+
+            continue;
+        }
+
+        if (m_profiles.count(profile) == 0) {
+            m_profiles.insert({ profile, cpu.threads().get(profile) });
+        }
+
+        std::vector<uint32_t> intensity{ 0 };
+        if (!isFixedIntensity(algorithm) && !sweep.intensity.empty()) {
+            intensity.clear();
+
+            for (uint32_t value : sweep.intensity) {
+                if (isValidIntensity(algorithm, value)) {
+                    intensity.push_back(value);
+                }
+                else {
+                    LOG_WARN("%s " YELLOW("sweep skips intensity ") WHITE_BOLD("%u") YELLOW(" for ") WHITE_BOLD("%s"), Tags::bench(), value, algorithm.name());
+                }
+            }
+        }
+
+        const std::vector<String> vms = algorithm.family() == Algorithm::RANDOM_X ? interpreters : std::vector<String>{ String() };
+
+        for (bool pages : hugePages) {
+            for (uint32_t count : threads) {
+                for (uint32_t value : intensity) {
+                    for (const String &vm : vms) {
+                        Point point;
+                        point.algorithm     = algorithm;
+                        point.hugePages     = pages;
+                        point.intensity     = value;
+                        point.interpreter   = vm;
+                        point.threads       = count;
+
+                        m_points.emplace_back(std::move(point));
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+xmrig::BenchSweep::~BenchSweep()
+{
+    delete m_timer;
+}
+
+
+void xmrig::BenchSweep::start()
+{
+    const auto &sweep   = m_benchmark->sweep();
+    const uint32_t size = m_benchmark->size();
+
+    LOG_NOTICE("%s " MAGENTA_BOLD("start benchmark sweep ") CYAN_BOLD("%zu") WHITE_BOLD(" points") " hashes " CYAN_BOLD("%u%s") " runs " CYAN_BOLD("%u") BLACK_BOLD(" (+%u warmup)"),
+               Tags::bench(),
+               m_points.size(),
+               size < 1000000 ? size / 1000 : size / 1000000,
+               size < 1000000 ? "K" : "M",
+               sweep.runs,
+               sweep.warmup);
+
+    if (m_points.empty()) {
+        return finish();
+    }
+
+    m_timer = new Timer(this);
+    m_timer->start(kTick, kTick);
+
+    run();
+}
+
+
+void xmrig::BenchSweep::onBenchDone(uint64_t result, uint64_t, uint64_t ts)
+{
+    Point &point        = m_points[m_point];
+    const uint32_t size = m_benchmark->size();
+    const double dt     = static_cast<double>(std::max<uint64_t>(ts - m_readyTime, 1)) / 1000.0;
+    const double value  = size / dt;
+    const bool warmup   = m_run < m_benchmark->sweep().warmup;
+
+    if ((point.hash && point.hash != result) || (point.reference && point.reference != result)) {
+        ++point.mismatches;
+    }
+
+    point.hash          = result;
+    point.scratchpads   = m_backend ? m_backend->hugePages() : HugePagesInfo();
+
+    if (!warmup) {
+        point.hashrate.push_back(value);
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (point.algorithm.family() == Algorithm::RANDOM_X) {
+        point.dataset = Rx::hugePages();
+
+        uint64_t compileTime = 0;
+        uint64_t totalTime   = 0;
+        randomx_get_jit_stats(&compileTime, &totalTime);
+
+        if (!warmup && totalTime) {
+            point.jitShare.push_back(static_cast<double>(compileTime) / totalTime);
+        }
+    }
+
+    randomx_set_jit_stats(false);
+#   endif
+
+    LOG_INFO("%s " WHITE_BOLD("%s") " run %u%s " CYAN_BOLD("%.3fs (%.1f h/s)") " hash %s%016" PRIX64 CLEAR,
+             Tags::bench(), point.algorithm.name(), m_run + 1, warmup ? " (warmup)" : "", dt, value,
+             point.reference ? (point.reference == result ? GREEN_BOLD_S : RED_BOLD_S) : BLACK_BOLD_S, result);
+
+    // BenchState is destroyed right after this callback, the next run is started from the timer.
+    m_state = StateDone;
+}
+
+
+void xmrig::BenchSweep::onBenchReady(uint64_t ts, uint32_t threads, const IBackend *backend)
+{
+    Point &point    = m_points[m_point];
+    m_readyTime     = ts;
+    m_backend       = backend;
+    m_state         = StateRunning;
+
+    if (m_run == 0) {
+        point.launched  = threads;
+        point.initTime  = ts - m_ts;
+        point.reference = BenchState::referenceHash(point.algorithm, m_benchmark->size(), threads);
+
+        if (!m_datasetReady) {
+            point.datasetInitTime = ts - m_ts;
+        }
+    }
+}
+
+
+void xmrig::BenchSweep::onTimer(const Timer *)
+{
+    if (m_state == StateDone) {
+        return next();
+    }
+
+    // A worker that failed its self test never reports completion, detect it by the lack of progress.
+    const uint64_t now = Chrono::steadyMSecs();
+    if (m_state == StateRunning && m_backend && m_backend->hashrate() && now - m_readyTime > kStallTimeout * 2 && m_backend->hashrate()->calc(kStallTimeout) <= 0.0) {
+        fail("no progress");
+    }
+}
+
+
+rapidjson::Value xmrig::BenchSweep::toJSON(rapidjson::Document &doc, const Point &point) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    double mean     = 0.0;
+    double stddev   = 0.0;
+    stats(point.hashrate, mean, stddev);
+
+    Value out(kObjectType);
+    out.AddMember("algo",       point.algorithm.toJSON(), allocator);
+    out.AddMember("threads",    point.launched, allocator);
+    out.AddMember("intensity",  point.intensity, allocator);
+    out.AddMember("huge-pages", point.hugePages, allocator);
+    out.AddMember("interpreter", point.interpreter.toJSON(), allocator);
+
+    Value hashrate(kObjectType);
+    Value samples(kArrayType);
+
+    for (double value : point.hashrate) {
+        samples.PushBack(Json::normalize(value, true), allocator);
+    }
+
+    hashrate.AddMember("mean",      Json::normalize(mean, true), allocator);
+    hashrate.AddMember("stddev",    Json::normalize(stddev, true), allocator);
+    hashrate.AddMember("min",       Json::normalize(point.hashrate.empty() ? 0.0 : *std::min_element(point.hashrate.begin(), point.hashrate.end()), true), allocator);
+    hashrate.AddMember("max",       Json::normalize(point.hashrate.empty() ? 0.0 : *std::max_element(point.hashrate.begin(), point.hashrate.end()), true), allocator);
+    hashrate.AddMember("samples",   samples, allocator);
+
+    out.AddMember("hashrate",           hashrate, allocator);
+    out.AddMember("init_ms",            point.initTime, allocator);
+    out.AddMember("dataset_init_ms",    point.datasetInitTime, allocator);
+
+    if (!point.jitShare.empty()) {
+        double share    = 0.0;
+        double unused   = 0.0;
+        stats(point.jitShare, share, unused);
+
+        out.AddMember("jit_share", share, allocator);
+    }
+    else {
+        out.AddMember("jit_share", kNullType, allocator);
+    }
+
+    Value memory(kObjectType);
+    memory.AddMember("scratchpads", static_cast<uint64_t>(point.scratchpads.size), allocator);
+    memory.AddMember("dataset",     static_cast<uint64_t>(point.dataset.size), allocator);
+
+    Value hugePages(kObjectType);
+    hugePages.AddMember("scratchpads",  xmrig::toJSON(point.scratchpads, doc), allocator);
+    hugePages.AddMember("dataset",      xmrig::toJSON(point.dataset, doc), allocator);
+
+    out.AddMember("memory",     memory, allocator);
+    out.AddMember("hugepages",  hugePages, allocator);
+    out.AddMember("hash",       Value(fmt::format("{:016X}", point.hash).c_str(), allocator), allocator);
+
+    if (point.reference) {
+        out.AddMember("reference",  Value(fmt::format("{:016X}", point.reference).c_str(), allocator), allocator);
+        out.AddMember("verified",   point.mismatches == 0 && point.hash == point.reference, allocator);
+    }
+    else {
+        out.AddMember("reference",  kNullType, allocator);
+        out.AddMember("verified",   kNullType, allocator);
+    }
+
+    out.AddMember("error", point.error.toJSON(), allocator);
+
+    return out;
+}
+
+
+void xmrig::BenchSweep::apply(const Point &point)
+{
+    auto &cpu               = m_controller->config()->cpu();
+    const String profile    = cpu.threads().profileName(point.algorithm);
+    const auto &data        = m_profiles.at(profile).data();
+    const size_t count      = point.threads ? point.threads : data.size();
+
+    CpuThreads threads;
+    for (size_t i = 0; i < count; ++i) {
+        const int64_t affinity      = i < data.size() ? data[i].affinity() : -1;
+        const uint32_t intensity    = point.intensity ? point.intensity : data[i % data.size()].intensity();
+
+        threads.add(affinity, intensity);
+    }
+
+    cpu.setHugePages(point.hugePages);
+    cpu.setThreads(profile, std::move(threads));
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (!point.interpreter.isNull()) {
+        m_controller->config()->rx().setInterpreter(RxConfig::interpreter(point.interpreter));
+    }
+#   endif
+}
+
+
+void xmrig::BenchSweep::fail(const char *error)
+{
+    Point &point = m_points[m_point];
+    point.error  = error;
+
+    LOG_ERR("%s " RED("%s threads %u intensity %u failed: ") RED_BOLD("%s"), Tags::bench(), point.algorithm.name(), point.threads, point.intensity, error);
+
+    m_state = StateDone;
+}
+
+
+void xmrig::BenchSweep::finish()
+{
+    if (m_timer) {
+        m_timer->stop();
+    }
+
+    m_controller->miner()->stop();
+    BenchState::destroy();
+
+    restore();
+    save();
+
+    LOG_INFO("%s " WHITE_BOLD("press ") MAGENTA_BOLD("Ctrl+C") WHITE_BOLD(" to exit"), Tags::bench());
+}
+
+
+void xmrig::BenchSweep::next()
+{
+    const auto &sweep   = m_benchmark->sweep();
+    const Point &point  = m_points[m_point];
+
+    if (++m_run < sweep.warmup + sweep.runs && point.error.isNull()) {
+        return run();
+    }
+
+    if (point.error.isNull()) {
+        double mean     = 0.0;
+        double stddev   = 0.0;
+        stats(point.hashrate, mean, stddev);
+
+        LOG_NOTICE("%s " WHITE_BOLD("%s") " threads " CYAN_BOLD("%u") " intensity " CYAN_BOLD("%u") " huge pages %s%s" WHITE_BOLD("%s") " " CYAN_BOLD("%.1f") CYAN(" \xC2\xB1 %.1f h/s") " %s",
+                   Tags::bench(), point.algorithm.name(), point.launched, point.intensity, point.hugePages ? GREEN_BOLD("on") : RED_BOLD("off"),
+                   point.interpreter.isNull() ? "" : " vm ", point.interpreter.isNull() ? "" : point.interpreter.data(), mean, stddev,
+                   point.reference ? (point.mismatches == 0 && point.hash == point.reference ? GREEN_BOLD("verified") : RED_BOLD("mismatch")) : BLACK_BOLD("unverified"));
+    }
+
+    m_run = 0;
+
+    if (++m_point < m_points.size()) {
+        return run();
+    }
+
+    finish();
+}
+
+
+void xmrig::BenchSweep::restore()
+{
+    auto &cpu = m_controller->config()->cpu();
+
+    for (const auto &kv : m_profiles) {
+        CpuThreads threads = kv.second;
+        cpu.setThreads(kv.first, std::move(threads));
+    }
+
+    cpu.setHugePages(m_hugePages);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    m_controller->config()->rx().setInterpreter(static_cast<RxConfig::Interpreter>(m_interpreter));
+#   endif
+}
+
+
+void xmrig::BenchSweep::run()
+{
+    const Point &point  = m_points[m_point];
+    const uint32_t size = m_benchmark->size();
+
+    if (m_run == 0) {
+        apply(point);
+    }
+
+    m_controller->miner()->stop();
+    BenchState::destroy();
+    BenchState::init(this, size);
+
+    std::vector<char> blob(112 * 2 + 1, '0');
+    blob.back() = '\0';
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    if (point.algorithm.family() == Algorithm::GHOSTRIDER) {
+        blob[ 8] = '1';
+        blob[ 9] = '0';
+        blob[11] = '2';
+    }
+#   endif
+
+    Job job(false, point.algorithm, kClientId);
+    job.setBlob(blob.data());
+    job.setDiff(std::numeric_limits<uint64_t>::max());
+    job.setHeight(1);
+    job.setId("00000000");
+
+    blob[Job::kMaxSeedSize * 2] = '\0';
+    job.setSeedHash(blob.data());
+    job.setBenchSize(size);
+
+    m_datasetReady = true;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (point.algorithm.family() == Algorithm::RANDOM_X) {
+        m_datasetReady = Rx::isReady(job);
+    }
+
+    randomx_set_jit_stats(true);
+#   endif
+
+    m_state = StateStarting;
+    m_ts    = Chrono::steadyMSecs();
+
+    m_controller->miner()->setJob(job, false);
+}
+
+
+void xmrig::BenchSweep::save() const
+{
+    using namespace rapidjson;
+
+    const auto &sweep = m_benchmark->sweep();
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    Value results(kArrayType);
+    for (const auto &point : m_points) {
+        results.PushBack(toJSON(doc, point), allocator);
+    }
+
+    doc.AddMember("version",    APP_VERSION, allocator);
+    doc.AddMember("cpu",        Cpu::toJSON(doc), allocator);
+    doc.AddMember("size",       m_benchmark->size(), allocator);
+    doc.AddMember("warmup",     sweep.warmup, allocator);
+    doc.AddMember("runs",       sweep.runs, allocator);
+    doc.AddMember("results",    results, allocator);
+
+    if (Json::save(sweep.report, doc)) {
+        LOG_NOTICE("%s " WHITE_BOLD("sweep report saved to ") CYAN_BOLD("\"%s\""), Tags::bench(), sweep.report.data());
+    }
+    else {
+        LOG_ERR("%s " RED("unable to save sweep report to ") RED_BOLD("\"%s\""), Tags::bench(), sweep.report.data());
+    }
+}
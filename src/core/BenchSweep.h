@@ -0,0 +1,131 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BENCHSWEEP_H
+#define XMRIG_BENCHSWEEP_H
+
+
+#include "backend/common/interfaces/IBenchListener.h"
+#include "backend/cpu/CpuThreads.h"
+#include "base/crypto/Algorithm.h"
+#include "base/kernel/interfaces/ITimerListener.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+#include "crypto/common/HugePagesInfo.h"
+
+
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class BenchConfig;
+class Controller;
+class Timer;
+
+
+/**
+ * Offline benchmark sweep ("benchmark": {"sweep": ...} or --bench-sweep=FILE).
+ *
+ * Runs the fixed-size benchmark over the cartesian product of algorithms,
+ * thread counts, intensities, huge pages settings and, for RandomX, virtual
+ * machines (JIT or one of the interpreters), repeats every point
+ * after optional warmup runs and writes a JSON report with hashrate
+ * statistics, initialization time, JIT share, memory usage and hash
+ * verification for each point.
+ */
+class BenchSweep : public IBenchListener, public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(BenchSweep)
+
+    constexpr static uint64_t kTick         = 250;
+    constexpr static uint64_t kStallTimeout = 60 * 1000;
+
+    BenchSweep(Controller *controller, const std::shared_ptr<BenchConfig> &benchmark);
+    ~BenchSweep() override;
+
+    void start();
+
+protected:
+    void onBenchDone(uint64_t result, uint64_t diff, uint64_t ts) override;
+    void onBenchReady(uint64_t ts, uint32_t threads, const IBackend *backend) override;
+    void onTimer(const Timer *timer) override;
+
+private:
+    enum State {
+        StateStarting,
+        StateRunning,
+        StateDone
+    };
+
+    struct Point
+    {
+        Algorithm algorithm;
+        bool hugePages;
+        uint32_t intensity;
+        uint32_t threads;
+
+        HugePagesInfo dataset;
+        HugePagesInfo scratchpads;
+        String error;
+        String interpreter;
+        std::vector<double> hashrate;
+        std::vector<double> jitShare;
+        uint32_t launched           = 0;
+        uint32_t mismatches         = 0;
+        uint64_t datasetInitTime    = 0;
+        uint64_t hash               = 0;
+        uint64_t initTime           = 0;
+        uint64_t reference          = 0;
+    };
+
+    const IBackend *backend() const;
+    rapidjson::Value toJSON(rapidjson::Document &doc, const Point &point) const;
+    void apply(const Point &point);
+    void fail(const char *error);
+    void finish();
+    void next();
+    void restore();
+    void run();
+    void save() const;
+
+    bool m_datasetReady         = false;
+    bool m_hugePages            = true;
+    int m_interpreter           = 0;
+    const IBackend *m_backend   = nullptr;
+    const std::shared_ptr<BenchConfig> m_benchmark;
+    Controller *m_controller;
+    size_t m_point              = 0;
+    State m_state               = StateStarting;
+    std::map<String, CpuThreads> m_profiles;
+    std::vector<Point> m_points;
+    Timer *m_timer              = nullptr;
+    uint32_t m_run              = 0;
+    uint64_t m_readyTime        = 0;
+    uint64_t m_ts               = 0;
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_BENCHSWEEP_H
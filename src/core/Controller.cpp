@@ -18,8 +18,11 @@
 
 #include "core/Controller.h"
 #include "backend/cpu/Cpu.h"
+#include "base/kernel/Startup.h"
+#include "base/tools/Chrono.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
+#include "crypto/common/HugePagesBudget.h"
 #include "crypto/common/VirtualMemory.h"
 #include "net/Network.h"
 
@@ -49,7 +52,17 @@ int xmrig::Controller::init()
 {
     Base::init();
 
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    // Only the memory pool is known at this point, the plan is completed with the first job.
+#   ifdef XMRIG_ALGO_RANDOMX
+    HugePagesBudget::plan(Algorithm(), config()->cpu(), &config()->rx());
+#   else
+    HugePagesBudget::plan(Algorithm(), config()->cpu());
+#   endif
+
     VirtualMemory::init(config()->cpu().memPoolSize(), config()->cpu().hugePageSize());
+    Startup::set(Startup::HUGE_PAGES, Chrono::steadyMSecs() - ts);
 
     m_network = std::make_shared<Network>(this);
 
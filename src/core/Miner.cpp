@@ -17,7 +17,6 @@
  */
 
 #include <algorithm>
-#include <mutex>
 #include <thread>
 
 
@@ -31,10 +30,12 @@
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
 #include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Object.h"
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesBudget.h"
 #include "crypto/common/Nonce.h"
 #include "version.h"
 
@@ -42,6 +43,8 @@
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "base/api/MetricsWriter.h"
+#   include "crypto/common/HugePagesInfo.h"
 #endif
 
 
@@ -62,15 +65,22 @@
 #endif
 
 
+#if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+#   include "crypto/rx/RxVerifier.h"
+#endif
+
+
 #ifdef XMRIG_ALGO_GHOSTRIDER
 #   include "crypto/ghostrider/ghostrider.h"
 #endif
 
 
-namespace xmrig {
+#ifdef XMRIG_FEATURE_POWER
+#   include "hw/power/PowerMeter.h"
+#endif
 
 
-static std::mutex mutex;
+namespace xmrig {
 
 
 class MinerPrivate
@@ -90,9 +100,17 @@ public:
             delete backend;
         }
 
+#       if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+        delete verifier;
+#       endif
+
 #       ifdef XMRIG_ALGO_RANDOMX
         Rx::destroy();
 #       endif
+
+#       ifdef XMRIG_FEATURE_POWER
+        delete power;
+#       endif
     }
 
 
@@ -111,6 +129,47 @@ public:
     inline void rebuild()
     {
         algorithms = Algorithm::all([this](const Algorithm &algo) { return isEnabled(algo); });
+
+#       ifdef XMRIG_FEATURE_POWER
+        const auto config = controller->config();
+        const String root = config->powerMeterRoot().isEmpty() ? String(PowerMeter::kDefaultRoot) : config->powerMeterRoot();
+
+        if (!config->isPowerMeter() || (power && power->root() != root)) {
+            delete power;
+            power = nullptr;
+        }
+
+        if (config->isPowerMeter() && !power) {
+            power = new PowerMeter(root);
+        }
+#       endif
+
+#       if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+        const auto &cpu         = controller->config()->cpu();
+        const uint32_t threads  = controller->config()->rx().verifyThreads();
+
+        if (verifier && verifier->threads() != threads) {
+            delete verifier;
+            verifier = nullptr;
+        }
+
+        if (threads && !verifier) {
+            verifier = new RxVerifier(threads, cpu.isHugePages(), cpu.isHwAES(), cpu.assembly());
+        }
+#       endif
+    }
+
+
+    inline void totalHashrate(double (&speed)[3]) const
+    {
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (hr) {
+                speed[0] += hr->calc(Hashrate::ShortInterval);
+                speed[1] += hr->calc(Hashrate::MediumInterval);
+                speed[2] += hr->calc(Hashrate::LargeInterval);
+            }
+        }
     }
 
 
@@ -161,6 +220,12 @@ public:
         }
 
         reply.AddMember("algorithms", algo, allocator);
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (verifier) {
+            reply.AddMember("verify", verifier->toJSON(doc), allocator);
+        }
+#       endif
     }
 
 
@@ -211,6 +276,12 @@ public:
         }
 
         reply.AddMember("hashrate", hashrate, allocator);
+
+#       ifdef XMRIG_FEATURE_POWER
+        if (power && power->isEnabled()) {
+            reply.AddMember("power", power->toJSON(t, doc), allocator);
+        }
+#       endif
     }
 
 
@@ -225,6 +296,190 @@ public:
             reply.PushBack(backend->toJSON(doc), allocator);
         }
     }
+
+
+    void getMetrics(MetricsWriter &metrics) const
+    {
+        static const char *windows[]    = { "10s", "60s", "15m" };
+        static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+        const char *algo = algorithm.isValid() ? algorithm.name() : "";
+
+        metrics.add("xmrig_hashrate", MetricsWriter::GAUGE, "Hashes per second by backend and averaging window.");
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (size_t i = 0; i < 3; ++i) {
+                metrics.sample("xmrig_hashrate", { { "backend", backend->type().data() }, { "algo", algo }, { "window", windows[i] } }, hr->calc(intervals[i]));
+            }
+        }
+
+        metrics.add("xmrig_thread_hashrate", MetricsWriter::GAUGE, "Hashes per second by worker thread and averaging window.");
+
+        char thread[24];
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            for (size_t t = 0; t < hr->threads(); ++t) {
+                snprintf(thread, sizeof(thread), "%zu", t);
+
+                for (size_t i = 0; i < 3; ++i) {
+                    metrics.sample("xmrig_thread_hashrate", { { "backend", backend->type().data() }, { "thread", thread }, { "window", windows[i] } }, hr->calc(t, intervals[i]));
+                }
+            }
+        }
+
+        metrics.add("xmrig_hashrate_max", MetricsWriter::GAUGE, "Highest total hashrate seen for the algorithm.");
+        metrics.sample("xmrig_hashrate_max", { { "algo", algo } }, maxHashrate[algorithm]);
+
+#       ifdef XMRIG_FEATURE_POWER
+        if (power && power->isEnabled()) {
+            double speed[3] = { 0.0 };
+            totalHashrate(speed);
+
+            metrics.add("xmrig_power_watts", MetricsWriter::GAUGE, "RAPL power draw by domain and averaging window.");
+
+            for (size_t i = 0; i < 3; ++i) {
+                metrics.sample("xmrig_power_watts", { { "domain", "package" }, { "window", windows[i] } }, power->watts(PowerMeter::PackageDomain, intervals[i]));
+
+                if (power->isDomain(PowerMeter::CoreDomain)) {
+                    metrics.sample("xmrig_power_watts", { { "domain", "core" }, { "window", windows[i] } }, power->watts(PowerMeter::CoreDomain, intervals[i]));
+                }
+            }
+
+            metrics.add("xmrig_joules_per_hash", MetricsWriter::GAUGE, "Package energy per hash by averaging window.");
+
+            for (size_t i = 0; i < 3; ++i) {
+                const double joules = PowerMeter::joulesPerHash(power->watts(PowerMeter::PackageDomain, intervals[i]), speed[i]);
+                if (joules > 0.0) {
+                    metrics.sample("xmrig_joules_per_hash", { { "algo", algo }, { "window", windows[i] } }, joules);
+                }
+            }
+        }
+#       endif
+
+        std::vector<std::pair<const char *, HugePagesInfo> > pages;
+        for (IBackend *backend : backends) {
+            if (backend->isEnabled()) {
+                pages.emplace_back(backend->type().data(), backend->hugePages());
+            }
+        }
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        pages.emplace_back("dataset", Rx::hugePages());
+#       endif
+
+        metrics.add("xmrig_hugepages_allocated", MetricsWriter::GAUGE, "Memory pages backed by huge pages.");
+        for (const auto &p : pages) {
+            metrics.sample("xmrig_hugepages_allocated", { { "memory", p.first } }, static_cast<uint64_t>(p.second.allocated));
+        }
+
+        metrics.add("xmrig_hugepages_requested", MetricsWriter::GAUGE, "Memory pages requested.");
+        for (const auto &p : pages) {
+            metrics.sample("xmrig_hugepages_requested", { { "memory", p.first } }, static_cast<uint64_t>(p.second.total));
+        }
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        metrics.add("xmrig_dataset_init_seconds", MetricsWriter::GAUGE, "Duration of the last RandomX dataset initialization.");
+        metrics.sample("xmrig_dataset_init_seconds", datasetMs / 1000.0);
+
+        metrics.add("xmrig_dataset_init_total", MetricsWriter::COUNTER, "Completed RandomX dataset initializations.");
+        metrics.sample("xmrig_dataset_init_total", datasetInits);
+
+        if (verifier) {
+            verifier->getMetrics(metrics);
+        }
+#       endif
+    }
+
+
+    void publishHashrate() const
+    {
+        using namespace rapidjson;
+
+        Api *api = controller->api();
+        if (!api->isStreaming()) {
+            return;
+        }
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        Value total(kArrayType);
+        Value list(kObjectType);
+
+        double t[3] = { 0.0 };
+
+        for (IBackend *backend : backends) {
+            const Hashrate *hr = backend->hashrate();
+            if (!hr) {
+                continue;
+            }
+
+            const double v[3] = { hr->calc(Hashrate::ShortInterval), hr->calc(Hashrate::MediumInterval), hr->calc(Hashrate::LargeInterval) };
+
+            Value hashrate(kArrayType);
+            for (size_t i = 0; i < 3; ++i) {
+                t[i] += v[i];
+                hashrate.PushBack(Hashrate::normalize(v[i]), allocator);
+            }
+
+            list.AddMember(backend->type().toJSON(), hashrate, allocator);
+        }
+
+        for (double value : t) {
+            total.PushBack(Hashrate::normalize(value), allocator);
+        }
+
+        doc.AddMember("algo",       algorithm.toJSON(), allocator);
+        doc.AddMember("total",      total, allocator);
+        doc.AddMember("backends",   list, allocator);
+
+        api->publish("hashrate", doc);
+    }
+
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    void publishDataset(bool ready)
+    {
+        using namespace rapidjson;
+
+        if (datasetPending == !ready) {
+            return;
+        }
+
+        datasetPending = !ready;
+
+        if (ready) {
+            datasetMs = Chrono::steadyMSecs() - datasetTs;
+            datasetInits++;
+        }
+        else {
+            datasetTs = Chrono::steadyMSecs();
+        }
+
+        Api *api = controller->api();
+        if (!api->isStreaming()) {
+            return;
+        }
+
+        Document doc(kObjectType);
+        auto &allocator = doc.GetAllocator();
+
+        doc.AddMember("state",  StringRef(ready ? "ready" : "init"), allocator);
+        doc.AddMember("algo",   job.algorithm().toJSON(), allocator);
+        doc.AddMember("height", job.height(), allocator);
+
+        api->publish("dataset", doc);
+    }
+#   endif
 #   endif
 
 
@@ -320,19 +575,32 @@ public:
         char avg_hashrate_buf[64];
         avg_hashrate_buf[0] = '\0';
 
+        char power_buf[80];
+        power_buf[0] = '\0';
+
+#       ifdef XMRIG_FEATURE_POWER
+        if (power && power->isEnabled()) {
+            const double watts = power->watts(PowerMeter::PackageDomain, Hashrate::ShortInterval);
+            const double hpj   = watts > 0.0 ? speed[0] / watts : 0.0;
+
+            snprintf(power_buf, sizeof(power_buf), " power " CYAN_BOLD("%.1f W %s %s/J"), watts, Hashrate::format(hpj * scale, num + 16 * 4, 16), scale < 1.0 ? "MH" : "H");
+        }
+#       endif
+
 #       ifdef XMRIG_ALGO_GHOSTRIDER
         if (algorithm.family() == Algorithm::GHOSTRIDER) {
             snprintf(avg_hashrate_buf, sizeof(avg_hashrate_buf), " avg " CYAN_BOLD("%s %s"), Hashrate::format(avg_hashrate * scale, num + 16 * 4, 16), h);
         }
 #       endif
 
-        LOG_INFO("%s " WHITE_BOLD("speed") " 10s/60s/15m " CYAN_BOLD("%s") CYAN(" %s %s ") CYAN_BOLD("%s") " max " CYAN_BOLD("%s %s") "%s",
+        LOG_INFO("%s " WHITE_BOLD("speed") " 10s/60s/15m " CYAN_BOLD("%s") CYAN(" %s %s ") CYAN_BOLD("%s") " max " CYAN_BOLD("%s %s") "%s%s",
                  Tags::miner(),
                  Hashrate::format(speed[0] * scale,                 num,          16),
                  Hashrate::format(speed[1] * scale,                 num + 16,     16),
                  Hashrate::format(speed[2] * scale,                 num + 16 * 2, 16), h,
                  Hashrate::format(maxHashrate[algorithm] * scale,   num + 16 * 3, 16), h,
-                 avg_hashrate_buf
+                 avg_hashrate_buf,
+                 power_buf
                  );
 
 #       ifdef XMRIG_FEATURE_BENCHMARK
@@ -345,6 +613,9 @@ public:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+    inline void planHugePages(const Algorithm &algo) const { HugePagesBudget::plan(algo, controller->config()->cpu(), &controller->config()->rx()); }
+#   else
+    inline void planHugePages(const Algorithm &algo) const { HugePagesBudget::plan(algo, controller->config()->cpu()); }
 #   endif
 
 
@@ -363,12 +634,27 @@ public:
     bool reset          = true;
     Controller *controller;
     Job job;
+    // Immutable copy of job published to the workers, replaced as a whole on every job change so workers
+    // pick it up without locking or copying.
+    std::shared_ptr<const Job> snapshot = std::make_shared<const Job>();
     mutable std::map<Algorithm::Id, double> maxHashrate;
     std::vector<IBackend *> backends;
     String userJobId;
     Timer *timer        = nullptr;
     uint64_t ticks      = 0;
 
+#   if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+    bool datasetPending   = false;
+    RxVerifier *verifier  = nullptr;
+    uint64_t datasetInits = 0;
+    uint64_t datasetMs    = 0;
+    uint64_t datasetTs    = 0;
+#   endif
+
+#   ifdef XMRIG_FEATURE_POWER
+    PowerMeter *power     = nullptr;
+#   endif
+
     Taskbar m_taskbar;
 };
 
@@ -447,11 +733,9 @@ const std::vector<xmrig::IBackend *> &xmrig::Miner::backends() const
 }
 
 
-xmrig::Job xmrig::Miner::job() const
+std::shared_ptr<const xmrig::Job> xmrig::Miner::job() const
 {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    return d_ptr->job;
+    return std::atomic_load(&d_ptr->snapshot);
 }
 
 
@@ -542,6 +826,10 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
         backend->prepare(job);
     }
 
+    if (d_ptr->algorithm != job.algorithm()) {
+        d_ptr->planHugePages(job.algorithm());
+    }
+
 #   ifdef XMRIG_ALGO_RANDOMX
     if (job.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(job)) {
         if (d_ptr->algorithm != job.algorithm()) {
@@ -556,8 +844,6 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
 
     d_ptr->algorithm = job.algorithm();
 
-    mutex.lock();
-
     const uint8_t index = donate ? 1 : 0;
 
     d_ptr->reset = !(d_ptr->job.index() == 1 && index == 0 && d_ptr->userJobId == job.id());
@@ -568,6 +854,8 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
         d_ptr->userJobId = job.id();
     }
 
+    std::atomic_store(&d_ptr->snapshot, std::make_shared<const Job>(d_ptr->job));
+
 #   ifdef XMRIG_ALGO_RANDOMX
     const bool ready = d_ptr->initRX();
 #   else
@@ -580,7 +868,11 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     }
 #   endif
 
-    mutex.unlock();
+#   if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+    if (job.algorithm().family() == Algorithm::RANDOM_X) {
+        d_ptr->publishDataset(ready);
+    }
+#   endif
 
     d_ptr->active = true;
     d_ptr->m_taskbar.setActive(true);
@@ -604,15 +896,14 @@ void xmrig::Miner::stop()
 void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
 {
     d_ptr->rebuild();
+    d_ptr->planHugePages(d_ptr->algorithm);
 
     if (config->pools() != previousConfig->pools() && config->pools().active() > 0) {
         return;
     }
 
-    const Job job = this->job();
-
     for (IBackend *backend : d_ptr->backends) {
-        backend->setJob(job);
+        backend->setJob(d_ptr->job);
     }
 }
 
@@ -641,11 +932,29 @@ void xmrig::Miner::onTimer(const Timer *)
 
     d_ptr->maxHashrate[d_ptr->algorithm] = std::max(d_ptr->maxHashrate[d_ptr->algorithm], maxHashrate);
 
+#   ifdef XMRIG_FEATURE_POWER
+    if (d_ptr->power && d_ptr->power->isEnabled()) {
+        d_ptr->power->tick(Chrono::steadyMSecs());
+    }
+#   endif
+
     const auto printTime = config->printTime();
     if (printTime && d_ptr->ticks && (d_ptr->ticks % (printTime * 2)) == 0) {
         d_ptr->printHashrate(false);
     }
 
+#   ifdef XMRIG_FEATURE_API
+    if ((d_ptr->ticks % 2) == 0) {
+        d_ptr->publishHashrate();
+    }
+#   endif
+
+#   if defined(XMRIG_FEATURE_API) && defined(XMRIG_ALGO_RANDOMX)
+    if (d_ptr->verifier) {
+        d_ptr->verifier->tick(Chrono::steadyMSecs());
+    }
+#   endif
+
     d_ptr->ticks++;
 
     auto autoPause = [this](bool &state, bool pause, const char *pauseMessage, const char *activeMessage)
@@ -674,6 +983,12 @@ void xmrig::Miner::onTimer(const Timer *)
 
 
 #ifdef XMRIG_FEATURE_API
+void xmrig::Miner::onMetrics(MetricsWriter &metrics)
+{
+    d_ptr->getMetrics(metrics);
+}
+
+
 void xmrig::Miner::onRequest(IApiRequest &request)
 {
     if (request.method() == IApiRequest::METHOD_GET) {
@@ -711,16 +1026,34 @@ void xmrig::Miner::onRequest(IApiRequest &request)
         backend->handleRequest(request);
     }
 }
+
+
+bool xmrig::Miner::onVerify(const HttpData &req)
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (d_ptr->verifier) {
+        d_ptr->verifier->submit(req, job());
+
+        return true;
+    }
+#   endif
+
+    return false;
+}
 #endif
 
 
 #ifdef XMRIG_ALGO_RANDOMX
 void xmrig::Miner::onDatasetReady()
 {
-    if (!Rx::isReady(job())) {
+    if (!Rx::isReady(d_ptr->job)) {
         return;
     }
 
+#   ifdef XMRIG_FEATURE_API
+    d_ptr->publishDataset(true);
+#   endif
+
     d_ptr->handleJobChange();
 }
 #endif
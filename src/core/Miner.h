@@ -20,6 +20,7 @@
 #define XMRIG_MINER_H
 
 
+#include <memory>
 #include <vector>
 
 
@@ -52,7 +53,7 @@ public:
     bool isEnabled(const Algorithm &algorithm) const;
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
-    Job job() const;
+    std::shared_ptr<const Job> job() const;
     void execCommand(char command);
     void pause();
     void setEnabled(bool enabled);
@@ -64,6 +65,8 @@ protected:
     void onTimer(const Timer *timer) override;
 
 #   ifdef XMRIG_FEATURE_API
+    bool onVerify(const HttpData &req) override;
+    void onMetrics(MetricsWriter &metrics) override;
     void onRequest(IApiRequest &request) override;
 #   endif
 
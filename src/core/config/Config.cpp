@@ -72,6 +72,11 @@ const char *Config::kHealthPrintTime    = "health-print-time";
 const char *Config::kDMI                = "dmi";
 #endif
 
+#ifdef XMRIG_FEATURE_POWER
+const char *Config::kPowerMeter         = "power-meter";
+const char *Config::kPowerMeterRoot     = "power-meter-root";
+#endif
+
 
 class ConfigPrivate
 {
@@ -100,6 +105,11 @@ public:
     bool dmi = true;
 #   endif
 
+#   ifdef XMRIG_FEATURE_POWER
+    bool powerMeter = false;
+    String powerMeterRoot;
+#   endif
+
     void setIdleTime(const rapidjson::Value &value)
     {
         if (value.IsBool()) {
@@ -138,6 +148,12 @@ const xmrig::CpuConfig &xmrig::Config::cpu() const
 }
 
 
+xmrig::CpuConfig &xmrig::Config::cpu()
+{
+    return d_ptr->cpu;
+}
+
+
 uint32_t xmrig::Config::idleTime() const
 {
     return d_ptr->idleTime * 1000U;
@@ -165,6 +181,12 @@ const xmrig::RxConfig &xmrig::Config::rx() const
 {
     return d_ptr->rx;
 }
+
+
+xmrig::RxConfig &xmrig::Config::rx()
+{
+    return d_ptr->rx;
+}
 #endif
 
 
@@ -184,6 +206,20 @@ bool xmrig::Config::isDMI() const
 #endif
 
 
+#ifdef XMRIG_FEATURE_POWER
+bool xmrig::Config::isPowerMeter() const
+{
+    return d_ptr->powerMeter;
+}
+
+
+const xmrig::String &xmrig::Config::powerMeterRoot() const
+{
+    return d_ptr->powerMeterRoot;
+}
+#endif
+
+
 bool xmrig::Config::isShouldSave() const
 {
     if (!isAutoSave()) {
@@ -244,6 +280,11 @@ bool xmrig::Config::read(const IJsonReader &reader, const char *fileName)
     d_ptr->dmi = reader.getBool(kDMI, d_ptr->dmi);
 #   endif
 
+#   ifdef XMRIG_FEATURE_POWER
+    d_ptr->powerMeter     = reader.getBool(kPowerMeter, d_ptr->powerMeter);
+    d_ptr->powerMeterRoot = reader.getString(kPowerMeterRoot);
+#   endif
+
     return true;
 }
 
@@ -282,6 +323,7 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
 #   endif
 
     doc.AddMember(StringRef(kLogFile),                  m_logFile.toJSON(), allocator);
+    doc.AddMember(StringRef(kLogFileSize),              m_logFileSize, allocator);
 
     m_pools.toJSON(doc, doc);
 
@@ -294,6 +336,11 @@ void xmrig::Config::getJSON(rapidjson::Document &doc) const
     doc.AddMember(StringRef(kDMI),                      isDMI(), allocator);
 #   endif
 
+#   ifdef XMRIG_FEATURE_POWER
+    doc.AddMember(StringRef(kPowerMeter),               isPowerMeter(), allocator);
+    doc.AddMember(StringRef(kPowerMeterRoot),           powerMeterRoot().toJSON(), allocator);
+#   endif
+
     doc.AddMember(StringRef(kSyslog),                   isSyslog(), allocator);
 
 #   ifdef XMRIG_FEATURE_TLS
@@ -64,6 +64,11 @@ public:
     static const char *kDMI;
 #   endif
 
+#   ifdef XMRIG_FEATURE_POWER
+    static const char *kPowerMeter;
+    static const char *kPowerMeterRoot;
+#   endif
+
     Config();
     ~Config() override;
 
@@ -71,6 +76,7 @@ public:
 
     bool isPauseOnBattery() const;
     const CpuConfig &cpu() const;
+    CpuConfig &cpu();
     uint32_t idleTime() const;
 
 #   ifdef XMRIG_FEATURE_OPENCL
@@ -84,6 +90,7 @@ public:
 
 #   ifdef XMRIG_ALGO_RANDOMX
     const RxConfig &rx() const;
+    RxConfig &rx();
 #   endif
 
 #   if defined(XMRIG_FEATURE_NVML) || defined (XMRIG_FEATURE_ADL)
@@ -98,6 +105,11 @@ public:
     static constexpr inline bool isDMI()    { return false; }
 #   endif
 
+#   ifdef XMRIG_FEATURE_POWER
+    bool isPowerMeter() const;
+    const String &powerMeterRoot() const;
+#   endif
+
     bool isShouldSave() const;
     bool read(const IJsonReader &reader, const char *fileName) override;
     void getJSON(rapidjson::Document &doc) const override;
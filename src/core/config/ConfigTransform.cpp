@@ -170,11 +170,17 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
 #   ifdef XMRIG_FEATURE_HWLOC
     case IConfig::RandomXNumaKey: /* --randomx-no-numa */
         return set(doc, RxConfig::kField, RxConfig::kNUMA, false);
+
+    case IConfig::RandomXInterleaveKey: /* --randomx-numa-interleave */
+        return set(doc, RxConfig::kField, RxConfig::kNUMA, RxConfig::kNUMAInterleave);
 #   endif
 
     case IConfig::RandomXModeKey: /* --randomx-mode */
         return set(doc, RxConfig::kField, RxConfig::kMode, arg);
 
+    case IConfig::RandomXMediumKey: /* --randomx-medium-size */
+        return set(doc, RxConfig::kField, RxConfig::kMediumSize, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
     case IConfig::RandomX1GbPagesKey: /* --randomx-1gb-pages */
         return set(doc, RxConfig::kField, RxConfig::kOneGbPages, true);
 
@@ -191,6 +197,12 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::RandomXCacheQoSKey: /* --cache-qos */
         return set(doc, RxConfig::kField, RxConfig::kCacheQoS, true);
 
+    case IConfig::RandomXInterpKey: /* --randomx-interpreter */
+        return set(doc, RxConfig::kField, RxConfig::kInterpreter, arg);
+
+    case IConfig::RandomXVerifyKey: /* --randomx-verify-threads */
+        return set(doc, RxConfig::kField, RxConfig::kVerifyThreads, static_cast<uint64_t>(strtol(arg, nullptr, 10)));
+
     case IConfig::HugePagesJitKey: /* --huge-pages-jit */
         return set(doc, CpuConfig::kField, CpuConfig::kHugePagesJit, true);
 #   endif
@@ -254,6 +266,7 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
 #   ifdef XMRIG_FEATURE_BENCHMARK
     case IConfig::AlgorithmKey:     /* --algo */
     case IConfig::BenchKey:         /* --bench */
+    case IConfig::BenchSweepKey:    /* --bench-sweep */
     case IConfig::StressKey:        /* --stress */
     case IConfig::BenchSubmitKey:   /* --submit */
     case IConfig::BenchVerifyKey:   /* --verify */
@@ -323,13 +336,14 @@ void xmrig::ConfigTransform::transformBenchmark(rapidjson::Document &doc, int ke
     case IConfig::AlgorithmKey: /* --algo */
         return set(doc, BenchConfig::kBenchmark, BenchConfig::kAlgo, arg);
 
-    case IConfig::BenchKey: /* --bench */
+    case IConfig::BenchKey:      /* --bench */
+    case IConfig::BenchSweepKey: /* --bench-sweep */
     {
         // CPU settings for the benchmark
         set(doc, CpuConfig::kField, CpuConfig::kHugePagesJit, true);
         set(doc, CpuConfig::kField, CpuConfig::kPriority, 2);
         set(doc, CpuConfig::kField, CpuConfig::kYield, false);
-        return set(doc, BenchConfig::kBenchmark, BenchConfig::kSize, arg);
+        return set(doc, BenchConfig::kBenchmark, key == IConfig::BenchKey ? BenchConfig::kSize : BenchConfig::kSweep, arg);
     }
 
     case IConfig::StressKey: /* --stress */
@@ -48,10 +48,13 @@ R"===(
         "init": -1,
         "init-avx2": -1,
         "mode": "auto",
+        "medium-size": 1024,
         "1gb-pages": false,
         "rdmsr": true,
         "wrmsr": true,
         "cache_qos": false,
+        "interpreter": "auto",
+        "verify-threads": 0,
         "numa": true,
         "scratchpad_prefetch_mode": 1
     },
@@ -63,9 +66,14 @@ R"===(
         "priority": null,
         "memory-pool": false,
         "yield": true,
+        "autotune": false,
         "max-threads-hint": 100,
         "asm": true,
         "argon2-impl": null,
+        "cgroup-root": null,
+        "topology-cache": false,
+        "telemetry": false,
+        "telemetry-root": null,
         "cn/0": false,
         "cn-lite/0": false
     },
@@ -88,6 +96,7 @@ R"===(
     "donate-level": 0,
     "donate-over-proxy": 1,
     "log-file": null,
+    "log-file-size": 0,
     "pools": [
         {
             "algo": null,
@@ -107,9 +116,12 @@ R"===(
             "submit-to-origin": false
         }
     ],
+    "pool-strategy": "failover",
     "print-time": 60,
     "health-print-time": 60,
     "dmi": true,
+    "power-meter": false,
+    "power-meter-root": "/sys/class/powercap",
     "retries": 5,
     "retry-pause": 5,
     "syslog": false,
@@ -64,6 +64,7 @@ static const option options[] = {
     { "dry-run",               0, nullptr, IConfig::DryRunKey             },
     { "keepalive",             0, nullptr, IConfig::KeepAliveKey          },
     { "log-file",              1, nullptr, IConfig::LogFileKey            },
+    { "log-file-size",         1, nullptr, IConfig::LogFileSizeKey        },
     { "nicehash",              0, nullptr, IConfig::NicehashKey           },
     { "rebench-algo",          0, nullptr, IConfig::RebenchAlgoKey        },
     { "bench-algo-time",       1, nullptr, IConfig::BenchAlgoTimeKey      },
@@ -107,6 +108,7 @@ static const option options[] = {
     { "stress",                0, nullptr, IConfig::StressKey             },
     { "bench",                 1, nullptr, IConfig::BenchKey              },
     { "benchmark",             1, nullptr, IConfig::BenchKey              },
+    { "bench-sweep",           1, nullptr, IConfig::BenchSweepKey         },
 #   ifdef XMRIG_FEATURE_HTTP
     { "submit",                0, nullptr, IConfig::BenchSubmitKey        },
     { "verify",                1, nullptr, IConfig::BenchVerifyKey        },
@@ -132,7 +134,9 @@ static const option options[] = {
 #   ifdef XMRIG_ALGO_RANDOMX
     { "randomx-init",          1, nullptr, IConfig::RandomXInitKey        },
     { "randomx-no-numa",       0, nullptr, IConfig::RandomXNumaKey        },
+    { "randomx-numa-interleave", 0, nullptr, IConfig::RandomXInterleaveKey },
     { "randomx-mode",          1, nullptr, IConfig::RandomXModeKey        },
+    { "randomx-medium-size",   1, nullptr, IConfig::RandomXMediumKey      },
     { "randomx-1gb-pages",     0, nullptr, IConfig::RandomX1GbPagesKey    },
     { "1gb-pages",             0, nullptr, IConfig::RandomX1GbPagesKey    },
     { "randomx-wrmsr",         2, nullptr, IConfig::RandomXWrmsrKey       },
@@ -141,6 +145,8 @@ static const option options[] = {
     { "no-rdmsr",              0, nullptr, IConfig::RandomXRdmsrKey       },
     { "randomx-cache-qos",     0, nullptr, IConfig::RandomXCacheQoSKey    },
     { "cache-qos",             0, nullptr, IConfig::RandomXCacheQoSKey    },
+    { "randomx-interpreter",   1, nullptr, IConfig::RandomXInterpKey      },
+    { "randomx-verify-threads", 1, nullptr, IConfig::RandomXVerifyKey     },
 #   endif
 #   ifdef XMRIG_FEATURE_OPENCL
     { "opencl",                0, nullptr, IConfig::OclKey                },
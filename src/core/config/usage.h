@@ -101,11 +101,15 @@ static inline const std::string &usage()
 #   ifdef XMRIG_ALGO_RANDOMX
     u += "      --randomx-init=N          threads count to initialize RandomX dataset\n";
     u += "      --randomx-no-numa         disable NUMA support for RandomX\n";
-    u += "      --randomx-mode=MODE       RandomX mode: auto, fast, light\n";
+    u += "      --randomx-numa-interleave single RandomX dataset interleaved across all NUMA nodes\n";
+    u += "      --randomx-mode=MODE       RandomX mode: auto, fast, light, medium\n";
+    u += "      --randomx-medium-size=MB  precomputed part of RandomX dataset in medium mode\n";
     u += "      --randomx-1gb-pages       use 1GB hugepages for RandomX dataset (Linux only)\n";
     u += "      --randomx-wrmsr=N         write custom value(s) to MSR registers or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
     u += "      --randomx-cache-qos       enable Cache QoS\n";
+    u += "      --randomx-interpreter=VM  RandomX VM: auto (JIT if available), threaded, bytecode\n";
+    u += "      --randomx-verify-threads=N threads for batch hash verification over HTTP API /2/verify\n";
 #   endif
 
 #   ifdef XMRIG_FEATURE_OPENCL
@@ -158,6 +162,7 @@ static inline const std::string &usage()
 #   endif
 
     u += "  -l, --log-file=FILE           log all output to a file\n";
+    u += "      --log-file-size=N         rotate log file after N megabytes (0 = never)\n";
     u += "      --print-time=N            print hashrate report every N seconds\n";
 #   if defined(XMRIG_FEATURE_NVML) || defined(XMRIG_FEATURE_ADL)
     u += "      --health-print-time=N     print health report every N seconds\n";
@@ -187,6 +192,7 @@ static inline const std::string &usage()
 #   ifdef XMRIG_FEATURE_BENCHMARK
     u += "      --stress                  run continuous stress test to check system stability\n";
     u += "      --bench=N                 run benchmark, N can be between 1M and 10M\n";
+    u += "      --bench-sweep=FILE        run benchmark sweep and save JSON report to FILE\n";
 #   ifdef XMRIG_FEATURE_HTTP
     u += "      --submit                  perform an online benchmark and submit result for sharing\n";
     u += "      --verify=ID               verify submitted benchmark by ID\n";
@@ -49,6 +49,33 @@ inline void single_hash(const uint8_t *__restrict__ input, size_t size, uint8_t
 }
 
 
+template<Algorithm::Id ALGO, size_t N>
+inline void multi_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
+{
+    static_assert(N <= ARGON2_MAX_INSTANCES, "too many Argon2 instances");
+
+    const void *in[N];
+    void *out[N];
+    void *memory[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        in[i]     = input + i * size;
+        out[i]    = output + i * 32;
+        memory[i] = ctx[i]->memory;
+    }
+
+    if (ALGO == Algorithm::AR2_CHUKWA) {
+        argon2id_hash_raw_ex_multi(3, 512, 1, in, size, in, 16, out, 32, memory, N);
+    }
+    else if (ALGO == Algorithm::AR2_CHUKWA_V2) {
+        argon2id_hash_raw_ex_multi(4, 1024, 1, in, size, in, 16, out, 32, memory, N);
+    }
+    else if (ALGO == Algorithm::AR2_WRKZ) {
+        argon2id_hash_raw_ex_multi(4, 256, 1, in, size, in, 16, out, 32, memory, N);
+    }
+}
+
+
 }} // namespace xmrig::argon2
 
 
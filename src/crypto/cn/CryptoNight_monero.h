@@ -206,5 +206,6 @@
 
 extern bool cn_sse41_enabled;
 extern bool cn_vaes_enabled;
+extern bool cn_vperm_enabled;
 
 #endif /* XMRIG_CRYPTONIGHT_MONERO_H */
@@ -47,6 +47,15 @@
 #   include "crypto/cn/CryptoNight_x86_vaes.h"
 #endif
 
+#ifdef XMRIG_FEATURE_SSSE3
+#   include "crypto/cn/CryptoNight_x86_vperm.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
 
 extern "C"
 {
@@ -235,14 +244,14 @@ void aes_round(__m128i key, __m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3,
 template<>
 NOINLINE void aes_round<true>(__m128i key, __m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, __m128i* x4, __m128i* x5, __m128i* x6, __m128i* x7)
 {
-    *x0 = soft_aesenc((uint32_t*)x0, key, (const uint32_t*)saes_table);
-    *x1 = soft_aesenc((uint32_t*)x1, key, (const uint32_t*)saes_table);
-    *x2 = soft_aesenc((uint32_t*)x2, key, (const uint32_t*)saes_table);
-    *x3 = soft_aesenc((uint32_t*)x3, key, (const uint32_t*)saes_table);
-    *x4 = soft_aesenc((uint32_t*)x4, key, (const uint32_t*)saes_table);
-    *x5 = soft_aesenc((uint32_t*)x5, key, (const uint32_t*)saes_table);
-    *x6 = soft_aesenc((uint32_t*)x6, key, (const uint32_t*)saes_table);
-    *x7 = soft_aesenc((uint32_t*)x7, key, (const uint32_t*)saes_table);
+    *x0 = soft_aesenc(*x0, key);
+    *x1 = soft_aesenc(*x1, key);
+    *x2 = soft_aesenc(*x2, key);
+    *x3 = soft_aesenc(*x3, key);
+    *x4 = soft_aesenc(*x4, key);
+    *x5 = soft_aesenc(*x5, key);
+    *x6 = soft_aesenc(*x6, key);
+    *x7 = soft_aesenc(*x7, key);
 }
 
 template<>
@@ -301,6 +310,13 @@ static NOINLINE void cn_explode_scratchpad(cryptonight_ctx *ctx)
     }
 #   endif
 
+#   ifdef XMRIG_FEATURE_SSSE3
+    if (SOFT_AES && !props.isHeavy() && cn_vperm_enabled) {
+        cn_explode_scratchpad_vperm(ctx, props.memory(), props.half_mem());
+        return;
+    }
+#   endif
+
     constexpr size_t N = (props.memory() / sizeof(__m128i)) / (props.half_mem() ? 2 : 1);
 
     __m128i xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7;
@@ -415,6 +431,13 @@ static NOINLINE void cn_implode_scratchpad(cryptonight_ctx *ctx)
     }
 #   endif
 
+#   ifdef XMRIG_FEATURE_SSSE3
+    if (SOFT_AES && !props.isHeavy() && cn_vperm_enabled) {
+        cn_implode_scratchpad_vperm(ctx, props.memory(), props.half_mem());
+        return;
+    }
+#   endif
+
     constexpr bool IS_HEAVY = props.isHeavy();
     constexpr size_t N = (props.memory() / sizeof(__m128i)) / (props.half_mem() ? 2 : 1);
 
@@ -588,9 +611,6 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 }
 
 
-void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
-
-
 alignas(64) static const uint32_t tweak1_table[256] = { 268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456 };
 
 
@@ -691,13 +711,7 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
 #   ifdef XMRIG_FEATURE_ASM
     if (SOFT_AES && props.isR()) {
         if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
-
+            ctx[0]->generated_code      = CnRCache::get(ALGO, height, CnRCache::SOFT_AES, Assembly::NONE, ctx[0]->generated_code);
             ctx[0]->generated_code_data = { ALGO, height };
         }
 
@@ -916,40 +930,13 @@ extern cn_mainloop_fun cn_gr4_quad_mainloop_asm;
 extern cn_mainloop_fun cn_gr5_quad_mainloop_asm;
 
 
-} // namespace xmrig
-
-
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code(code, code_size, machine_code, ASM);
-}
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code_double(code, code_size, machine_code, ASM);
-}
-
-
-namespace xmrig {
-
-
 template<Algorithm::Id ALGO, Assembly::Id ASM>
 inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t height)
 {
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRCache::get(ALGO, height, CnRCache::SINGLE, ASM, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -1052,10 +1039,7 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
+        ctx[0]->generated_code      = CnRCache::get(ALGO, height, CnRCache::DOUBLE, ASM, ctx[0]->generated_code);
         ctx[0]->generated_code_data = { ALGO, height };
     }
 
@@ -0,0 +1,257 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CryptoNight_x86_vperm.h"
+#include "CryptoNight_monero.h"
+#include "CryptoNight.h"
+#include "crypto/common/VpermAes.h"
+
+
+// Soft AES explode/implode for CPUs without AES-NI, this file is compiled with -mssse3 and used only if the CPU has SSSE3.
+
+
+static FORCEINLINE __m128i sl_xor(__m128i tmp1)
+{
+    __m128i tmp4;
+    tmp4 = _mm_slli_si128(tmp1, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    tmp4 = _mm_slli_si128(tmp4, 0x04);
+    tmp1 = _mm_xor_si128(tmp1, tmp4);
+    return tmp1;
+}
+
+
+// Same as _mm_shuffle_epi32(_mm_aeskeygenassist_si128(x, rcon), 0xFF) and _mm_shuffle_epi32(_mm_aeskeygenassist_si128(x, 0), 0xAA).
+template<uint8_t rcon>
+static FORCEINLINE void vperm_genkey_sub(__m128i* xout0, __m128i* xout2)
+{
+    const __m128i rot_word = _mm_setr_epi8(13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15, 12, 13, 14, 15, 12);
+
+    __m128i xout1 = _mm_xor_si128(_mm_shuffle_epi8(xmrig::vperm_subbytes(*xout2), rot_word), _mm_set1_epi32(rcon));
+    *xout0 = sl_xor(*xout0);
+    *xout0 = _mm_xor_si128(*xout0, xout1);
+    xout1  = _mm_shuffle_epi32(xmrig::vperm_subbytes(*xout0), 0xFF);
+    *xout2 = sl_xor(*xout2);
+    *xout2 = _mm_xor_si128(*xout2, xout1);
+}
+
+
+static NOINLINE void vperm_genkey(const __m128i* memory, __m128i* k0, __m128i* k1, __m128i* k2, __m128i* k3, __m128i* k4, __m128i* k5, __m128i* k6, __m128i* k7, __m128i* k8, __m128i* k9)
+{
+    __m128i xout0 = _mm_load_si128(memory);
+    __m128i xout2 = _mm_load_si128(memory + 1);
+    *k0 = xout0;
+    *k1 = xout2;
+
+    vperm_genkey_sub<0x01>(&xout0, &xout2);
+    *k2 = xout0;
+    *k3 = xout2;
+
+    vperm_genkey_sub<0x02>(&xout0, &xout2);
+    *k4 = xout0;
+    *k5 = xout2;
+
+    vperm_genkey_sub<0x04>(&xout0, &xout2);
+    *k6 = xout0;
+    *k7 = xout2;
+
+    vperm_genkey_sub<0x08>(&xout0, &xout2);
+    *k8 = xout0;
+    *k9 = xout2;
+}
+
+
+static FORCEINLINE void vperm_round(__m128i key, __m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3, __m128i& x4, __m128i& x5, __m128i& x6, __m128i& x7)
+{
+    x0 = xmrig::vperm_aesenc(x0, key);
+    x1 = xmrig::vperm_aesenc(x1, key);
+    x2 = xmrig::vperm_aesenc(x2, key);
+    x3 = xmrig::vperm_aesenc(x3, key);
+    x4 = xmrig::vperm_aesenc(x4, key);
+    x5 = xmrig::vperm_aesenc(x5, key);
+    x6 = xmrig::vperm_aesenc(x6, key);
+    x7 = xmrig::vperm_aesenc(x7, key);
+}
+
+
+namespace xmrig {
+
+
+NOINLINE void cn_explode_scratchpad_vperm(cryptonight_ctx* ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m128i xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7;
+    __m128i k0, k1, k2, k3, k4, k5, k6, k7, k8, k9;
+
+    const __m128i* input = reinterpret_cast<const __m128i*>(ctx->state);
+    __m128i* output = reinterpret_cast<__m128i*>(ctx->memory);
+
+    vperm_genkey(input, &k0, &k1, &k2, &k3, &k4, &k5, &k6, &k7, &k8, &k9);
+
+    if (half_mem && !ctx->first_half) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(ctx->save_state);
+        xin0 = _mm_load_si128(p + 0);
+        xin1 = _mm_load_si128(p + 1);
+        xin2 = _mm_load_si128(p + 2);
+        xin3 = _mm_load_si128(p + 3);
+        xin4 = _mm_load_si128(p + 4);
+        xin5 = _mm_load_si128(p + 5);
+        xin6 = _mm_load_si128(p + 6);
+        xin7 = _mm_load_si128(p + 7);
+    }
+    else {
+        xin0 = _mm_load_si128(input + 4);
+        xin1 = _mm_load_si128(input + 5);
+        xin2 = _mm_load_si128(input + 6);
+        xin3 = _mm_load_si128(input + 7);
+        xin4 = _mm_load_si128(input + 8);
+        xin5 = _mm_load_si128(input + 9);
+        xin6 = _mm_load_si128(input + 10);
+        xin7 = _mm_load_si128(input + 11);
+    }
+
+    constexpr int output_increment = 64 / sizeof(__m128i);
+    constexpr int prefetch_dist = 2048 / sizeof(__m128i);
+
+    __m128i* e = output + N - prefetch_dist;
+    __m128i* prefetch_ptr = output + prefetch_dist;
+
+    for (int i = 0; i < 2; ++i) {
+        do {
+            _mm_prefetch((const char*)(prefetch_ptr), _MM_HINT_T0);
+            _mm_prefetch((const char*)(prefetch_ptr + output_increment), _MM_HINT_T0);
+
+            vperm_round(k0, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k1, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k2, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k3, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k4, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k5, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k6, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k7, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k8, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+            vperm_round(k9, xin0, xin1, xin2, xin3, xin4, xin5, xin6, xin7);
+
+            _mm_store_si128(output + 0, xin0);
+            _mm_store_si128(output + 1, xin1);
+            _mm_store_si128(output + 2, xin2);
+            _mm_store_si128(output + 3, xin3);
+
+            _mm_store_si128(output + output_increment + 0, xin4);
+            _mm_store_si128(output + output_increment + 1, xin5);
+            _mm_store_si128(output + output_increment + 2, xin6);
+            _mm_store_si128(output + output_increment + 3, xin7);
+
+            output += output_increment * 2;
+            prefetch_ptr += output_increment * 2;
+        } while (output < e);
+        e += prefetch_dist;
+        prefetch_ptr = output;
+    }
+
+    if (half_mem && ctx->first_half) {
+        __m128i* p = reinterpret_cast<__m128i*>(ctx->save_state);
+        _mm_store_si128(p + 0, xin0);
+        _mm_store_si128(p + 1, xin1);
+        _mm_store_si128(p + 2, xin2);
+        _mm_store_si128(p + 3, xin3);
+        _mm_store_si128(p + 4, xin4);
+        _mm_store_si128(p + 5, xin5);
+        _mm_store_si128(p + 6, xin6);
+        _mm_store_si128(p + 7, xin7);
+    }
+}
+
+
+NOINLINE void cn_implode_scratchpad_vperm(cryptonight_ctx* ctx, size_t memory, bool half_mem)
+{
+    const size_t N = (memory / sizeof(__m128i)) / (half_mem ? 2 : 1);
+
+    __m128i xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7;
+    __m128i k0, k1, k2, k3, k4, k5, k6, k7, k8, k9;
+
+    const __m128i* input = reinterpret_cast<const __m128i*>(ctx->memory);
+    __m128i* output = reinterpret_cast<__m128i*>(ctx->state);
+
+    vperm_genkey(output + 2, &k0, &k1, &k2, &k3, &k4, &k5, &k6, &k7, &k8, &k9);
+
+    xout0 = _mm_load_si128(output + 4);
+    xout1 = _mm_load_si128(output + 5);
+    xout2 = _mm_load_si128(output + 6);
+    xout3 = _mm_load_si128(output + 7);
+    xout4 = _mm_load_si128(output + 8);
+    xout5 = _mm_load_si128(output + 9);
+    xout6 = _mm_load_si128(output + 10);
+    xout7 = _mm_load_si128(output + 11);
+
+    const __m128i* input_begin = input;
+    for (size_t part = 0; part < (half_mem ? 2 : 1); ++part) {
+        if (half_mem && (part == 1)) {
+            input = input_begin;
+            ctx->first_half = false;
+            cn_explode_scratchpad_vperm(ctx, memory, half_mem);
+        }
+
+        for (size_t i = 0; i < N;) {
+            constexpr int input_increment = 64 / sizeof(__m128i);
+
+            xout0 = _mm_xor_si128(_mm_load_si128(input + 0), xout0);
+            xout1 = _mm_xor_si128(_mm_load_si128(input + 1), xout1);
+            xout2 = _mm_xor_si128(_mm_load_si128(input + 2), xout2);
+            xout3 = _mm_xor_si128(_mm_load_si128(input + 3), xout3);
+            xout4 = _mm_xor_si128(_mm_load_si128(input + input_increment + 0), xout4);
+            xout5 = _mm_xor_si128(_mm_load_si128(input + input_increment + 1), xout5);
+            xout6 = _mm_xor_si128(_mm_load_si128(input + input_increment + 2), xout6);
+            xout7 = _mm_xor_si128(_mm_load_si128(input + input_increment + 3), xout7);
+
+            input += input_increment * 2;
+            i += 8;
+
+            if (i < N) {
+                _mm_prefetch((const char*)(input), _MM_HINT_T0);
+                _mm_prefetch((const char*)(input + input_increment), _MM_HINT_T0);
+            }
+
+            vperm_round(k0, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k1, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k2, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k3, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k4, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k5, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k6, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k7, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k8, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+            vperm_round(k9, xout0, xout1, xout2, xout3, xout4, xout5, xout6, xout7);
+        }
+    }
+
+    _mm_store_si128(output + 4, xout0);
+    _mm_store_si128(output + 5, xout1);
+    _mm_store_si128(output + 6, xout2);
+    _mm_store_si128(output + 7, xout3);
+    _mm_store_si128(output + 8, xout4);
+    _mm_store_si128(output + 9, xout5);
+    _mm_store_si128(output + 10, xout6);
+    _mm_store_si128(output + 11, xout7);
+}
+
+
+} // xmrig
@@ -0,0 +1,233 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/r/CnRCache.h"
+#include "crypto/cn/CryptoNight_monero.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <limits>
+#include <mutex>
+#include <vector>
+
+
+void v4_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_compile_code_double(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+
+
+namespace xmrig {
+
+
+// Slots referenced by a worker context are pinned until it switches to other code or is destroyed, only unpinned
+// slots are evicted (least recently used first), another block of slots is added when all of them are pinned.
+static constexpr size_t kCodeSize   = 0x4000;
+static constexpr size_t kSlots      = 16;
+
+
+struct CnRCacheEntry
+{
+    inline bool match(int a, uint64_t h, uint32_t v, uint32_t asmId) const { return algorithm == a && height == h && variant == v && assembly == asmId; }
+
+    int algorithm       = Algorithm::INVALID;
+    uint32_t assembly   = Assembly::NONE;
+    uint32_t variant    = CnRCache::VARIANT_MAX;
+    uint64_t height     = std::numeric_limits<uint64_t>::max();
+    uint64_t used       = 0;
+    uint8_t *code       = nullptr;
+    uint32_t refs       = 0;
+};
+
+
+static std::mutex mutex;
+static std::vector<CnRCacheEntry> entries;
+static std::vector<uint8_t *> blocks;
+static uint64_t counter = 0;
+
+
+static CnRCacheEntry *find(cn_mainloop_fun_ms_abi fn)
+{
+    for (auto &entry : entries) {
+        if (fn && entry.code == reinterpret_cast<uint8_t *>(fn)) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+
+static CnRCacheEntry *slot()
+{
+    CnRCacheEntry *out = nullptr;
+
+    for (auto &entry : entries) {
+        if (entry.refs == 0 && (!out || entry.used < out->used)) {
+            out = &entry;
+        }
+    }
+
+    if (out) {
+        return out;
+    }
+
+    auto memory = static_cast<uint8_t *>(VirtualMemory::allocateExecutableMemory(kCodeSize * kSlots, false));
+    if (!memory) {
+        return nullptr;
+    }
+
+    blocks.emplace_back(memory);
+    entries.resize(entries.size() + kSlots);
+
+    for (size_t i = 0; i < kSlots; ++i) {
+        entries[entries.size() - kSlots + i].code = memory + i * kCodeSize;
+    }
+
+    return &entries[entries.size() - kSlots];
+}
+
+
+static CnRCacheEntry *generate(Algorithm::Id algorithm, uint64_t height, CnRCache::Variant variant, Assembly::Id assembly)
+{
+    for (auto &entry : entries) {
+        if (entry.match(algorithm, height, variant, assembly)) {
+            entry.used = ++counter;
+
+            return &entry;
+        }
+    }
+
+    V4_Instruction code[256];
+    int code_size = 0;
+
+    switch (algorithm) {
+    case Algorithm::CN_R:
+        code_size = v4_random_math_init<Algorithm::CN_R>(code, height);
+        break;
+
+    default:
+        return nullptr;
+    }
+
+    auto entry = slot();
+    if (!entry) {
+        return nullptr;
+    }
+
+    uint8_t *p = entry->code;
+    VirtualMemory::protectRW(p, kCodeSize);
+
+    switch (variant) {
+    case CnRCache::SINGLE:
+        v4_compile_code(code, code_size, p, assembly);
+        break;
+
+    case CnRCache::DOUBLE:
+        v4_compile_code_double(code, code_size, p, assembly);
+        break;
+
+    default:
+        v4_soft_aes_compile_code(code, code_size, p, Assembly::NONE);
+        break;
+    }
+
+    VirtualMemory::protectRX(p, kCodeSize);
+
+    entry->algorithm = algorithm;
+    entry->assembly  = assembly;
+    entry->variant   = variant;
+    entry->height    = height;
+    entry->used      = ++counter;
+
+    return entry;
+}
+
+
+} // namespace xmrig
+
+
+cn_mainloop_fun_ms_abi xmrig::CnRCache::get(Algorithm::Id algorithm, uint64_t height, Variant variant, Assembly::Id assembly, cn_mainloop_fun_ms_abi previous)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto entry = generate(algorithm, height, variant, assembly);
+    if (entry) {
+        ++entry->refs;
+    }
+
+    // The previous code is unpinned after the new one is pinned, so it is never evicted to make room for it.
+    auto old = find(previous);
+    if (old && old->refs) {
+        --old->refs;
+    }
+
+    return entry ? reinterpret_cast<cn_mainloop_fun_ms_abi>(entry->code) : nullptr;
+}
+
+
+void xmrig::CnRCache::prepare(const Algorithm &algorithm, uint64_t height, CnHash::AlgoVariant av, Assembly::Id assembly)
+{
+    if (algorithm != Algorithm::CN_R) {
+        return;
+    }
+
+    Variant variant = VARIANT_MAX;
+
+    if (av == CnHash::AV_SINGLE_SOFT) {
+        variant  = SOFT_AES;
+        assembly = Assembly::NONE;
+    }
+    else if (assembly != Assembly::NONE && av == CnHash::AV_SINGLE) {
+        variant = SINGLE;
+    }
+    else if (assembly != Assembly::NONE && av == CnHash::AV_DOUBLE) {
+        variant = DOUBLE;
+    }
+    else {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    generate(algorithm.id(), height, variant, assembly);
+    generate(algorithm.id(), height + 1, variant, assembly);
+}
+
+
+void xmrig::CnRCache::release()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto memory : blocks) {
+        VirtualMemory::freeLargePagesMemory(memory, kCodeSize * kSlots);
+    }
+
+    blocks.clear();
+    entries.clear();
+}
+
+
+void xmrig::CnRCache::unpin(cn_mainloop_fun_ms_abi code)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto entry = find(code);
+    if (entry && entry->refs) {
+        --entry->refs;
+    }
+}
@@ -0,0 +1,64 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CNRCACHE_H
+#define XMRIG_CNRCACHE_H
+
+
+#include "base/crypto/Algorithm.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/Assembly.h"
+
+
+namespace xmrig
+{
+
+
+/**
+ * Process-wide cache of CryptoNight-R main loops generated for a block height.
+ *
+ * Code is keyed by (algorithm, height, variant, assembly), generated once and
+ * shared read-execute by all workers. prepare() is called on job arrival for
+ * the job height and the next one, get() generates on a miss as a fallback.
+ *
+ * get() pins the returned code and unpins the previous code of the context,
+ * unpin() is called when the context is destroyed. Pinned code is never
+ * evicted or rewritten.
+ */
+class CnRCache
+{
+public:
+    enum Variant : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES,
+        VARIANT_MAX
+    };
+
+    static cn_mainloop_fun_ms_abi get(Algorithm::Id algorithm, uint64_t height, Variant variant, Assembly::Id assembly, cn_mainloop_fun_ms_abi previous);
+    static void prepare(const Algorithm &algorithm, uint64_t height, CnHash::AlgoVariant av, Assembly::Id assembly);
+    static void release();
+    static void unpin(cn_mainloop_fun_ms_abi code);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CNRCACHE_H */
@@ -0,0 +1,399 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/common/HugePagesBudget.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuConfig.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "crypto/common/MemoryPool.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxCache.h"
+#   include "crypto/rx/RxConfig.h"
+#   include "crypto/rx/RxDataset.h"
+#endif
+
+
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/common/LinuxMemory.h"
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static const char *usageNames[HugePagesBudget::UsageMax] = { "dataset", "cache", "scratchpads", "pool", "jit" };
+
+
+// RandomX JIT code buffer upper bound (CodeSize * 4 with the AVX2 dataset init).
+constexpr size_t kJitSize = 256 * 1024;
+
+
+class HugePagesBucket
+{
+public:
+    inline uint64_t planned() const
+    {
+        uint64_t out = 0;
+        for (uint64_t pages : usage) {
+            out += pages;
+        }
+
+        return out;
+    }
+
+    inline void reset()
+    {
+        reserved = 0;
+        std::fill(std::begin(usage), std::end(usage), 0);
+    }
+
+    uint64_t claimed                            = 0;
+    uint64_t reserved                           = 0;
+    uint64_t usage[HugePagesBudget::UsageMax]   = {};
+    uint64_t used                               = 0;
+};
+
+
+// Budget buckets by NUMA node and page size, allocated pages stay accounted across plans.
+static std::map<std::pair<uint32_t, size_t>, HugePagesBucket> buckets;
+static std::mutex mutex;
+static bool committed = true;
+
+
+static inline uint64_t pagesOf(size_t size, size_t pageSize)
+{
+    return size ? VirtualMemory::align(size, pageSize) / pageSize : 0;
+}
+
+
+static inline void add(HugePagesBudget::Usage usage, uint32_t node, size_t size, size_t pageSize)
+{
+    const uint64_t pages = pagesOf(size, pageSize);
+    if (pages) {
+        buckets[{ node, pageSize }].usage[usage] += pages;
+    }
+}
+
+
+// Interleaved memory takes the same share of pages from every node, rounded up.
+static inline uint64_t shareOf(size_t size, size_t pageSize, size_t nodes)
+{
+    return nodes ? (pagesOf(size, pageSize) + nodes - 1) / nodes : 0;
+}
+
+
+static inline void spread(HugePagesBudget::Usage usage, const std::vector<uint32_t> &nodes, size_t size, size_t pageSize)
+{
+    const uint64_t pages = shareOf(size, pageSize, nodes.size());
+
+    for (uint32_t node : nodes) {
+        add(usage, node, pages * pageSize, pageSize);
+    }
+}
+
+
+// Grows the kernel pools once for the whole plan, on the first allocation after it, so the event loop is not
+// blocked while the kernel compacts memory.
+static void commit()
+{
+    committed = true;
+
+#   ifdef XMRIG_OS_LINUX
+    uint64_t planned  = 0;
+    uint64_t reserved = 0;
+
+    for (auto &kv : buckets) {
+        auto &bucket          = kv.second;
+        const uint32_t node   = kv.first.first;
+        const size_t pageSize = kv.first.second;
+        const uint64_t pages  = bucket.planned();
+
+        if (pages == 0) {
+            continue;
+        }
+
+        if (pages > bucket.used) {
+            LinuxMemory::reserve((pages - bucket.used) * pageSize, node, pageSize);
+        }
+
+        const int64_t available = LinuxMemory::freeHugePages(node, pageSize);
+        bucket.reserved         = std::min<uint64_t>(pages, bucket.used + static_cast<uint64_t>(std::max<int64_t>(available, 0)));
+
+        planned  += pages * pageSize;
+        reserved += bucket.reserved * pageSize;
+    }
+
+    if (planned) {
+        LOG_INFO("%s " WHITE_BOLD("huge pages budget ") CYAN_BOLD("%" PRIu64 " MB") " reserved %s%" PRIu64 " MB",
+                 Tags::cpu(),
+                 planned / 1024 / 1024,
+                 reserved == planned ? GREEN_BOLD_S : (reserved == 0 ? RED_BOLD_S : YELLOW_BOLD_S),
+                 reserved / 1024 / 1024
+                 );
+    }
+#   endif
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::HugePagesBudget::reserve(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!committed) {
+        commit();
+    }
+
+    // Pages are claimed until take() or cancel(), so concurrent allocations can't count the same budget twice.
+    const uint64_t pages = shareOf(size, pageSize, nodes.size());
+    bool result          = true;
+
+    for (uint32_t node : nodes) {
+        auto &bucket        = buckets[{ node, pageSize }];
+        const bool budgeted = bucket.used + bucket.claimed + pages <= bucket.reserved;
+
+        bucket.claimed += pages;
+
+        if (!budgeted) {
+#           ifdef XMRIG_OS_LINUX
+            result = LinuxMemory::reserve(pages * pageSize, node, pageSize) && result;
+#           else
+            result = false;
+#           endif
+        }
+    }
+
+    return result;
+}
+
+
+void xmrig::HugePagesBudget::cancel(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const uint64_t pages = shareOf(size, pageSize, nodes.size());
+
+    for (uint32_t node : nodes) {
+        auto &bucket = buckets[{ node, pageSize }];
+        bucket.claimed -= std::min(bucket.claimed, pages);
+    }
+}
+
+
+void xmrig::HugePagesBudget::plan(const Algorithm &algorithm, const CpuConfig &cpu, const RxConfig *rx)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto &kv : buckets) {
+        kv.second.reset();
+    }
+
+    const size_t pageSize = cpu.hugePageSize();
+    if (pageSize == 0) {
+        committed = true;
+
+        return;
+    }
+
+    const uint32_t nodes = std::max<uint32_t>(Cpu::info()->nodes(), 1);
+    const size_t poolSize = cpu.memPoolSize();
+    std::map<uint32_t, size_t> pool;
+
+    // A single node pool is allocated at startup, NUMA pools are created on the nodes used by the threads.
+    if (poolSize && nodes == 1) {
+        pool[0] = poolSize * MemoryPool::kPageSize;
+    }
+
+    if (algorithm.isValid() && cpu.isEnabled()) {
+        std::map<uint32_t, size_t> scratchpads;
+        std::map<uint32_t, size_t> threads;
+
+        for (const auto &thread : cpu.threads().get(algorithm).data()) {
+            const uint32_t node = VirtualMemory::nodeOf(thread.affinity());
+
+            scratchpads[node] += VirtualMemory::align(algorithm.l3() * thread.intensity(), pageSize);
+            threads[node]++;
+        }
+
+        for (const auto &kv : scratchpads) {
+            if (poolSize && nodes > 1) {
+                pool[kv.first] = std::max<size_t>(VirtualMemory::align(poolSize, nodes) / nodes, 1) * MemoryPool::kPageSize;
+            }
+
+            const size_t pooled = pool.count(kv.first) ? pool.at(kv.first) : 0;
+            if (kv.second > pooled) {
+                add(ScratchpadsUsage, kv.first, kv.second - pooled, pageSize);
+            }
+        }
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        if (rx && algorithm.family() == Algorithm::RANDOM_X) {
+            // Same storage selection as RxQueue, NUMA storage allocates a full dataset on every node of the set,
+            // interleaved storage spreads a single dataset and cache evenly across the nodes of the set.
+            auto nodeset          = rx->nodeset();
+            const bool interleave = !nodeset.empty() && rx->isNUMAInterleave();
+            const bool numa       = !nodeset.empty() && !interleave;
+            if (nodeset.empty()) {
+                nodeset = { 0 };
+            }
+
+            const bool full       = numa || (rx->mode() != RxConfig::LightMode && rx->mode() != RxConfig::MediumMode);
+            const bool oneGbPages = full && rx->isOneGbPages() && VirtualMemory::isOneGbPagesAvailable();
+
+            if (full) {
+                if (interleave) {
+                    spread(DatasetUsage, nodeset, RxDataset::maxSize(), oneGbPages ? VirtualMemory::kOneGiB : pageSize);
+                }
+                else {
+                    for (uint32_t node : nodeset) {
+                        add(DatasetUsage, node, RxDataset::maxSize(), oneGbPages ? VirtualMemory::kOneGiB : pageSize);
+                    }
+                }
+            }
+            else if (rx->mode() == RxConfig::MediumMode) {
+                const size_t size = std::min<size_t>(static_cast<size_t>(rx->mediumSize()) * 1024U * 1024U, RxDataset::maxSize());
+
+                if (interleave) {
+                    spread(DatasetUsage, nodeset, size, pageSize);
+                }
+                else {
+                    add(DatasetUsage, 0, size, pageSize);
+                }
+            }
+
+            // With 1GB pages the cache is placed in the dataset slack.
+            if (!oneGbPages && interleave) {
+                spread(CacheUsage, nodeset, RxCache::maxSize(), pageSize);
+            }
+            else if (!oneGbPages) {
+                add(CacheUsage, nodeset.front(), RxCache::maxSize(), pageSize);
+            }
+
+            if (cpu.isHugePagesJit()) {
+                for (const auto &kv : threads) {
+                    add(JitUsage, kv.first, kv.second * VirtualMemory::align(kJitSize, pageSize), pageSize);
+                }
+            }
+        }
+#       endif
+    }
+
+    for (const auto &kv : pool) {
+        add(PoolUsage, kv.first, kv.second + MemoryPool::kAlignment, pageSize);
+    }
+
+    committed = false;
+}
+
+
+void xmrig::HugePagesBudget::release(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const uint64_t pages = shareOf(size, pageSize, nodes.size());
+
+    for (uint32_t node : nodes) {
+        auto &bucket = buckets[{ node, pageSize }];
+        bucket.used -= std::min(bucket.used, pages);
+    }
+}
+
+
+void xmrig::HugePagesBudget::take(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const uint64_t pages = shareOf(size, pageSize, nodes.size());
+
+    for (uint32_t node : nodes) {
+        auto &bucket = buckets[{ node, pageSize }];
+
+        bucket.claimed -= std::min(bucket.claimed, pages);
+        bucket.used    += pages;
+    }
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::HugePagesBudget::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t planned   = 0;
+    uint64_t allocated = 0;
+
+    Value list(kArrayType);
+
+    for (const auto &kv : buckets) {
+        const auto &bucket   = kv.second;
+        const uint64_t pages = bucket.planned();
+        if (pages == 0 && bucket.used == 0) {
+            continue;
+        }
+
+        Value item(kObjectType);
+        item.AddMember("node",      kv.first.first, allocator);
+        item.AddMember("page_size", static_cast<uint64_t>(kv.first.second), allocator);
+        item.AddMember("planned",   pages, allocator);
+
+#       ifdef XMRIG_OS_LINUX
+        item.AddMember("reserved",  committed ? Value(bucket.reserved) : Value(kNullType), allocator);
+#       else
+        item.AddMember("reserved",  Value(kNullType), allocator);
+#       endif
+
+        item.AddMember("allocated", bucket.used, allocator);
+
+        for (uint32_t i = 0; i < UsageMax; ++i) {
+            item.AddMember(StringRef(usageNames[i]), bucket.usage[i], allocator);
+        }
+
+        list.PushBack(item, allocator);
+
+        // JIT buffers are reserved with the rest of the budget but allocated outside of VirtualMemory.
+        const uint64_t tracked = pages - bucket.usage[JitUsage];
+
+        planned   += tracked * kv.first.second;
+        allocated += std::min(tracked, bucket.used) * kv.first.second;
+    }
+
+    Value out(kObjectType);
+    out.AddMember("coverage", planned ? static_cast<double>(allocated) / planned : 0.0, allocator);
+    out.AddMember("nodes",    list, allocator);
+
+    return out;
+}
+#endif
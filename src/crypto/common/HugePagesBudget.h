@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_HUGEPAGESBUDGET_H
+#define XMRIG_HUGEPAGESBUDGET_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class CpuConfig;
+class RxConfig;
+
+
+class HugePagesBudget
+{
+public:
+    enum Usage : uint32_t {
+        DatasetUsage,
+        CacheUsage,
+        ScratchpadsUsage,
+        PoolUsage,
+        JitUsage,
+        UsageMax
+    };
+
+    // Memory interleaved across several nodes is accounted as an equal share of pages on each of them.
+    static bool reserve(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize);
+    static void cancel(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize);
+    static void plan(const Algorithm &algorithm, const CpuConfig &cpu, const RxConfig *rx = nullptr);
+    static void release(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize);
+    static void take(size_t size, const std::vector<uint32_t> &nodes, size_t pageSize);
+
+#   ifdef XMRIG_FEATURE_API
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+#   endif
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_HUGEPAGESBUDGET_H */
@@ -64,6 +64,12 @@ bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize
 }
 
 
+int64_t xmrig::LinuxMemory::freeHugePages(uint32_t node, size_t hugePageSize)
+{
+    return free_hugepages(node, hugePageSize);
+}
+
+
 bool xmrig::LinuxMemory::write(const char *path, uint64_t value)
 {
     std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
@@ -32,26 +32,15 @@
 #include <cassert>
 
 
-namespace xmrig {
-
-
-constexpr size_t pageSize = 2 * 1024 * 1024;
-
-
-} // namespace xmrig
-
-
 xmrig::MemoryPool::MemoryPool(size_t size, bool hugePages, uint32_t node)
 {
     if (!size) {
         return;
     }
 
-    constexpr size_t alignment = 1 << 24;
-
-    m_memory = new VirtualMemory(size * pageSize + alignment, hugePages, false, false, node);
+    m_memory = new VirtualMemory(size * kPageSize + kAlignment, hugePages, false, false, node);
 
-    m_alignOffset = (alignment - (((size_t)m_memory->scratchpad()) % alignment)) % alignment;
+    m_alignOffset = (kAlignment - (((size_t)m_memory->scratchpad()) % kAlignment)) % kAlignment;
 }
 
 
@@ -69,7 +58,7 @@ bool xmrig::MemoryPool::isHugePages(uint32_t) const
 
 uint8_t *xmrig::MemoryPool::get(size_t size, uint32_t)
 {
-    assert(!(size % pageSize));
+    assert(!(size % kPageSize));
 
     if (!m_memory || (m_memory->size() - m_offset - m_alignOffset) < size) {
         return nullptr;
@@ -43,6 +43,9 @@ class MemoryPool : public IMemoryPool
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(MemoryPool)
 
+    constexpr static size_t kPageSize   = 2 * 1024 * 1024;
+    constexpr static size_t kAlignment  = 1 << 24;
+
     MemoryPool(size_t size, bool hugePages, uint32_t node = 0);
     ~MemoryPool() override;
 
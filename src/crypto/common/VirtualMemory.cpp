@@ -38,6 +38,7 @@ namespace xmrig {
 
 
 size_t VirtualMemory::m_hugePageSize    = VirtualMemory::kDefaultHugePageSize;
+thread_local std::vector<uint32_t> VirtualMemory::m_interleave;
 static IMemoryPool *pool                = nullptr;
 static std::mutex mutex;
 
@@ -45,11 +46,14 @@ static std::mutex mutex;
 } // namespace xmrig
 
 
-xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize) :
+xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node, size_t alignSize, bool populate) :
     m_size(alignToHugePageSize(size)),
     m_node(node),
+    m_nodes(m_interleave.empty() ? std::vector<uint32_t>{ node } : m_interleave),
     m_capacity(m_size)
 {
+    m_flags.set(FLAG_DEFERRED, !populate && !usePool);
+
     if (usePool) {
         std::lock_guard<std::mutex> lock(mutex);
         if (hugePages && !pool->isHugePages(node) && allocateLargePagesMemory()) {
@@ -74,6 +78,7 @@ xmrig::VirtualMemory::VirtualMemory(size_t size, bool hugePages, bool oneGbPages
         return;
     }
 
+    m_flags.set(FLAG_DEFERRED, false);
     m_scratchpad = static_cast<uint8_t*>(_mm_malloc(m_size, alignSize));
 }
 
@@ -104,10 +109,34 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 
 
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::VirtualMemory::bindToNode(uint32_t)
+{
+    return false;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOf(int64_t)
+{
+    return 0;
+}
+
+
+bool xmrig::VirtualMemory::interleave(const std::vector<uint32_t> &)
+{
+    return false;
+}
+
+
+std::map<uint32_t, size_t> xmrig::VirtualMemory::placement(const void *, size_t, size_t)
+{
+    return {};
+}
 #endif
 
 
@@ -28,7 +28,9 @@
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <utility>
+#include <vector>
 
 
 namespace xmrig {
@@ -42,7 +44,7 @@ public:
     constexpr static size_t kDefaultHugePageSize    = 2U * 1024U * 1024U;
     constexpr static size_t kOneGiB                 = 1024U * 1024U * 1024U;
 
-    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64);
+    VirtualMemory(size_t size, bool hugePages, bool oneGbPages, bool usePool, uint32_t node = 0, size_t alignSize = 64, bool populate = true);
     ~VirtualMemory();
 
     inline bool isHugePages() const                                 { return m_flags.test(FLAG_HUGEPAGES); }
@@ -55,18 +57,25 @@ public:
     inline static void flushInstructionCache(void *p1, void *p2)    { flushInstructionCache(p1, static_cast<uint8_t*>(p2) - static_cast<uint8_t*>(p1)); }
 
     HugePagesInfo hugePages() const;
+    void prefault(uint32_t threads, int64_t node = -1);
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
     static bool protectRW(void *p, size_t size);
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
+    static bool bindToNode(uint32_t nodeId);
+    static bool interleave(const std::vector<uint32_t> &nodeset);
+    static std::map<uint32_t, size_t> placement(const void *p, size_t size, size_t pageSize);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static uint32_t nodeOf(int64_t affinity);
+    static void *allocateDualMappedMemory(size_t size, void **exec);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
     static void destroy();
     static void flushInstructionCache(void *p, size_t size);
+    static void freeDualMappedMemory(void *p, void *exec, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
 
@@ -80,6 +89,7 @@ private:
         FLAG_1GB_PAGES,
         FLAG_LOCK,
         FLAG_EXTERNAL,
+        FLAG_DEFERRED,
         FLAG_MAX
     };
 
@@ -90,9 +100,11 @@ private:
     void freeLargePagesMemory();
 
     static size_t m_hugePageSize;
+    static thread_local std::vector<uint32_t> m_interleave;
 
     const size_t m_size;
     const uint32_t m_node;
+    const std::vector<uint32_t> m_nodes;
     size_t m_capacity;
     std::bitset<FLAG_MAX> m_flags;
     uint8_t *m_scratchpad = nullptr;
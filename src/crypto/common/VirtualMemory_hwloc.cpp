@@ -28,6 +28,15 @@
 #include <hwloc.h>
 
 
+bool xmrig::VirtualMemory::bindToNode(uint32_t nodeId)
+{
+    auto cpu         = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
+
+    return node && cpu->membind(node->nodeset) && hwloc_set_cpubind(cpu->topology(), node->cpuset, HWLOC_CPUBIND_THREAD) >= 0;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 {
     if (affinity < 0 || Cpu::info()->nodes() < 2) {
@@ -45,3 +54,65 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 
     return hwloc_bitmap_first(pu->nodeset);
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOf(int64_t affinity)
+{
+    if (affinity < 0 || Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    auto cpu       = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(cpu->topology(), static_cast<unsigned>(affinity));
+
+    return pu ? hwloc_bitmap_first(pu->nodeset) : 0;
+}
+
+
+bool xmrig::VirtualMemory::interleave(const std::vector<uint32_t> &nodeset)
+{
+    if (nodeset.size() < 2) {
+        return false;
+    }
+
+    auto cpu                = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_bitmap_t bitmap   = hwloc_bitmap_alloc();
+
+    for (uint32_t nodeId : nodeset) {
+        hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
+        if (node) {
+            hwloc_bitmap_or(bitmap, bitmap, node->nodeset);
+        }
+    }
+
+    const bool result = hwloc_bitmap_weight(bitmap) > 1 && cpu->interleave(bitmap);
+    hwloc_bitmap_free(bitmap);
+
+    // Memory allocated by this thread from now on is accounted in the huge pages budget of every node of the set.
+    m_interleave = result ? nodeset : std::vector<uint32_t>();
+
+    return result;
+}
+
+
+std::map<uint32_t, size_t> xmrig::VirtualMemory::placement(const void *p, size_t size, size_t pageSize)
+{
+    std::map<uint32_t, size_t> out;
+
+#   if HWLOC_API_VERSION >= 0x20000
+    auto cpu              = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_bitmap_t bitmap = hwloc_bitmap_alloc();
+    auto ptr              = static_cast<const uint8_t *>(p);
+
+    // Pages that are not faulted in yet have no location and are skipped.
+    for (size_t offset = 0; offset < size; offset += pageSize) {
+        if (hwloc_get_area_memlocation(cpu->topology(), ptr + offset, 1, bitmap, HWLOC_MEMBIND_BYNODESET) == 0 && !hwloc_bitmap_iszero(bitmap)) {
+            out[static_cast<uint32_t>(hwloc_bitmap_first(bitmap))]++;
+        }
+    }
+
+    hwloc_bitmap_free(bitmap);
+#   endif
+
+    return out;
+}
@@ -20,12 +20,17 @@
 
 #include "crypto/common/VirtualMemory.h"
 #include "backend/cpu/Cpu.h"
+#include "crypto/common/HugePagesBudget.h"
 #include "crypto/common/portable/mm_malloc.h"
 
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
 
 
 #ifdef XMRIG_OS_APPLE
@@ -43,8 +48,13 @@
 #endif
 
 
-#ifdef XMRIG_OS_LINUX
-#   include "crypto/common/LinuxMemory.h"
+#if defined(__linux__)
+#   include <sys/syscall.h>
+#endif
+
+
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC 0x0001U
 #endif
 
 
@@ -73,6 +83,36 @@ static inline int hugePagesFlag(size_t size)
 #endif
 
 
+// Huge pages are reserved by mmap() in both cases, without MAP_POPULATE they are faulted in and zeroed later
+// by the threads that touch them first, see VirtualMemory::prefault().
+static void *allocateLargePages(size_t size, bool populate)
+{
+#   if defined(XMRIG_OS_APPLE)
+    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
+#   elif defined(__FreeBSD__)
+    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_ALIGNED_SUPER | MAP_PREFAULT_READ, -1, 0);
+#   else
+    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (populate ? MAP_POPULATE : 0) | hugePagesFlag(xmrig::VirtualMemory::hugePageSize()), 0, 0);
+#   endif
+
+    return mem == MAP_FAILED ? nullptr : mem;
+}
+
+
+static void *allocateOneGbPages(size_t size, bool populate)
+{
+#   ifdef XMRIG_OS_LINUX
+    if (xmrig::VirtualMemory::isOneGbPagesAvailable()) {
+        void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (populate ? MAP_POPULATE : 0) | hugePagesFlag(xmrig::VirtualMemory::kOneGiB), 0, 0);
+
+        return mem == MAP_FAILED ? nullptr : mem;
+    }
+#   endif
+
+    return nullptr;
+}
+
+
 bool xmrig::VirtualMemory::isHugepagesAvailable()
 {
 #   if defined(XMRIG_OS_MACOS) && defined(XMRIG_ARM)
@@ -122,6 +162,47 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    // Two views of the same shared memory object: a writable one for the JIT and an executable one for running
+    // the generated code, so no page is ever writable and executable at the same time.
+#   if defined(__linux__) && defined(SYS_memfd_create)
+    const int fd = static_cast<int>(syscall(SYS_memfd_create, "xmrig-jit", MFD_CLOEXEC));
+#   elif defined(__FreeBSD__)
+    const int fd = shm_open(SHM_ANON, O_RDWR | O_CLOEXEC, 0600);
+#   else
+    const int fd = -1;
+#   endif
+
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+
+        return nullptr;
+    }
+
+    void *rw = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void *rx = rw != MAP_FAILED ? mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0) : MAP_FAILED;
+
+    close(fd);
+
+    if (rx == MAP_FAILED) {
+        if (rw != MAP_FAILED) {
+            munmap(rw, size);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return rw;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
 #   if defined(XMRIG_OS_APPLE)
@@ -160,29 +241,13 @@ void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages
 
 void *xmrig::VirtualMemory::allocateLargePagesMemory(size_t size)
 {
-#   if defined(XMRIG_OS_APPLE)
-    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
-#   elif defined(__FreeBSD__)
-    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_ALIGNED_SUPER | MAP_PREFAULT_READ, -1, 0);
-#   else
-    void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(hugePageSize()), 0, 0);
-#   endif
-
-    return mem == MAP_FAILED ? nullptr : mem;
+    return allocateLargePages(size, true);
 }
 
 
 void *xmrig::VirtualMemory::allocateOneGbPagesMemory(size_t size)
 {
-#   ifdef XMRIG_OS_LINUX
-    if (isOneGbPagesAvailable()) {
-        void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE | hugePagesFlag(kOneGiB), 0, 0);
-
-        return mem == MAP_FAILED ? nullptr : mem;
-    }
-#   endif
-
-    return nullptr;
+    return allocateOneGbPages(size, true);
 }
 
 
@@ -196,12 +261,68 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t size)
+{
+    munmap(exec, size);
+    munmap(p, size);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t size)
 {
     munmap(p, size);
 }
 
 
+void xmrig::VirtualMemory::prefault(uint32_t threads, int64_t node)
+{
+    if (!m_flags.test(FLAG_DEFERRED)) {
+        return;
+    }
+
+    m_flags.set(FLAG_DEFERRED, false);
+
+    // Each thread touches a contiguous range of pages, the same split as the dataset init threads use, the kernel
+    // zeroes every page in the faulting thread and places it by that thread memory policy. scripts/dataset_alloc.sh
+    // compares the "dataset_alloc" startup phase with one prefault thread and with one thread per CPU.
+    const size_t pageSize = isOneGbPages() ? kOneGiB : hugePageSize();
+    const size_t pages    = (m_capacity + pageSize - 1) / pageSize;
+    const size_t count    = std::max<size_t>(std::min<size_t>(threads, pages), 1);
+
+    auto touch = [this, node, pageSize, pages, count](size_t index) {
+        if (node >= 0) {
+            bindToNode(static_cast<uint32_t>(node));
+        }
+
+        volatile uint8_t *p = m_scratchpad;
+
+        for (size_t i = pages * index / count; i < pages * (index + 1) / count; ++i) {
+            p[i * pageSize] = 0;
+        }
+    };
+
+    if (count > 1) {
+        std::vector<std::thread> workers;
+        workers.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            workers.emplace_back(touch, i);
+        }
+
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+    else {
+        touch(0);
+    }
+
+    if (mlock(m_scratchpad, m_size) == 0) {
+        m_flags.set(FLAG_LOCK, true);
+    }
+}
+
+
 void xmrig::VirtualMemory::osInit(size_t hugePageSize)
 {
     if (hugePageSize) {
@@ -213,22 +334,27 @@ void xmrig::VirtualMemory::osInit(size_t hugePageSize)
 bool xmrig::VirtualMemory::allocateLargePagesMemory()
 {
 #   ifdef XMRIG_OS_LINUX
-    LinuxMemory::reserve(m_size, m_node, hugePageSize());
+    HugePagesBudget::reserve(m_size, m_nodes, hugePageSize());
 #   endif
 
-    m_scratchpad = static_cast<uint8_t*>(allocateLargePagesMemory(m_size));
+    m_scratchpad = static_cast<uint8_t*>(allocateLargePages(m_size, !m_flags.test(FLAG_DEFERRED)));
     if (m_scratchpad) {
         m_flags.set(FLAG_HUGEPAGES, true);
+        HugePagesBudget::take(m_size, m_nodes, hugePageSize());
 
         madvise(m_scratchpad, m_size, MADV_RANDOM | MADV_WILLNEED);
 
-        if (mlock(m_scratchpad, m_size) == 0) {
+        if (!m_flags.test(FLAG_DEFERRED) && mlock(m_scratchpad, m_size) == 0) {
             m_flags.set(FLAG_LOCK, true);
         }
 
         return true;
     }
 
+#   ifdef XMRIG_OS_LINUX
+    HugePagesBudget::cancel(m_size, m_nodes, hugePageSize());
+#   endif
+
     return false;
 }
 
@@ -236,22 +362,27 @@ bool xmrig::VirtualMemory::allocateLargePagesMemory()
 bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 {
 #   ifdef XMRIG_OS_LINUX
-    LinuxMemory::reserve(m_size, m_node, kOneGiB);
+    HugePagesBudget::reserve(m_size, m_nodes, kOneGiB);
 #   endif
 
-    m_scratchpad = static_cast<uint8_t*>(allocateOneGbPagesMemory(m_size));
+    m_scratchpad = static_cast<uint8_t*>(allocateOneGbPages(m_size, !m_flags.test(FLAG_DEFERRED)));
     if (m_scratchpad) {
         m_flags.set(FLAG_1GB_PAGES, true);
+        HugePagesBudget::take(m_size, m_nodes, kOneGiB);
 
         madvise(m_scratchpad, m_size, MADV_RANDOM | MADV_WILLNEED);
 
-        if (mlock(m_scratchpad, m_size) == 0) {
+        if (!m_flags.test(FLAG_DEFERRED) && mlock(m_scratchpad, m_size) == 0) {
             m_flags.set(FLAG_LOCK, true);
         }
 
         return true;
     }
 
+#   ifdef XMRIG_OS_LINUX
+    HugePagesBudget::cancel(m_size, m_nodes, kOneGiB);
+#   endif
+
     return false;
 }
 
@@ -262,5 +393,6 @@ void xmrig::VirtualMemory::freeLargePagesMemory()
         munlock(m_scratchpad, m_size);
     }
 
+    HugePagesBudget::release(m_size, m_nodes, isOneGbPages() ? kOneGiB : hugePageSize());
     freeLargePagesMemory(m_scratchpad, m_size);
 }
@@ -26,6 +26,7 @@
 
 #include "crypto/common/VirtualMemory.h"
 #include "base/io/log/Log.h"
+#include "crypto/common/HugePagesBudget.h"
 #include "crypto/common/portable/mm_malloc.h"
 
 
@@ -186,6 +187,33 @@ bool xmrig::VirtualMemory::protectRX(void *p, size_t size)
 }
 
 
+void *xmrig::VirtualMemory::allocateDualMappedMemory(size_t size, void **exec)
+{
+    const uint64_t size64 = size;
+    HANDLE mapping        = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_EXECUTE_READWRITE | SEC_COMMIT, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+
+    void *rw = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    void *rx = rw ? MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, size) : nullptr;
+
+    CloseHandle(mapping);
+
+    if (!rx) {
+        if (rw) {
+            UnmapViewOfFile(rw);
+        }
+
+        return nullptr;
+    }
+
+    *exec = rx;
+
+    return rw;
+}
+
+
 void *xmrig::VirtualMemory::allocateExecutableMemory(size_t size, bool hugePages)
 {
     void* result = nullptr;
@@ -227,12 +255,24 @@ void xmrig::VirtualMemory::flushInstructionCache(void *p, size_t size)
 }
 
 
+void xmrig::VirtualMemory::freeDualMappedMemory(void *p, void *exec, size_t)
+{
+    UnmapViewOfFile(exec);
+    UnmapViewOfFile(p);
+}
+
+
 void xmrig::VirtualMemory::freeLargePagesMemory(void *p, size_t)
 {
     VirtualFree(p, 0, MEM_RELEASE);
 }
 
 
+void xmrig::VirtualMemory::prefault(uint32_t, int64_t)
+{
+}
+
+
 void xmrig::VirtualMemory::osInit(size_t hugePageSize)
 {
     if (hugePageSize) {
@@ -246,6 +286,7 @@ bool xmrig::VirtualMemory::allocateLargePagesMemory()
     m_scratchpad = static_cast<uint8_t*>(allocateLargePagesMemory(m_size));
     if (m_scratchpad) {
         m_flags.set(FLAG_HUGEPAGES, true);
+        HugePagesBudget::take(m_size, m_nodes, hugePageSize());
 
         return true;
     }
@@ -262,5 +303,6 @@ bool xmrig::VirtualMemory::allocateOneGbPagesMemory()
 
 void xmrig::VirtualMemory::freeLargePagesMemory()
 {
+    HugePagesBudget::release(m_size, m_nodes, hugePageSize());
     freeLargePagesMemory(m_scratchpad, m_size);
 }
@@ -0,0 +1,170 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_VPERMAES_H
+#define XMRIG_VPERMAES_H
+
+
+#include <cstdint>
+#include <tmmintrin.h>
+
+
+/*
+ * Constant time AES round for CPUs without AES-NI, SubBytes is computed with
+ * vector permutes (pshufb) only, no table lookups depend on secret data.
+ *
+ * Every byte is mapped to GF(2^4)^2, the nibble inversions are done with
+ * 16 byte tables and the output tables merge the inverse basis change with
+ * the S-box affine transform and the MixColumns multipliers.
+ *
+ * Requires SSSE3, translation units that include this file must be compiled
+ * with -mssse3 and selected at runtime with ICpuInfo::FLAG_SSSE3.
+ */
+
+
+namespace xmrig {
+
+
+namespace vperm {
+
+
+static inline __m128i lut(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3, uint8_t b4, uint8_t b5, uint8_t b6, uint8_t b7, uint8_t b8, uint8_t b9, uint8_t b10, uint8_t b11, uint8_t b12, uint8_t b13, uint8_t b14, uint8_t b15)
+{
+    return _mm_setr_epi8(static_cast<char>(b0), static_cast<char>(b1), static_cast<char>(b2), static_cast<char>(b3), static_cast<char>(b4), static_cast<char>(b5), static_cast<char>(b6), static_cast<char>(b7),
+                         static_cast<char>(b8), static_cast<char>(b9), static_cast<char>(b10), static_cast<char>(b11), static_cast<char>(b12), static_cast<char>(b13), static_cast<char>(b14), static_cast<char>(b15));
+}
+
+
+static inline __m128i pshufb(__m128i table, __m128i index) { return _mm_shuffle_epi8(table, index); }
+
+
+// Input byte (AES basis) to the tower field basis, encryption and decryption (the latter also removes the S-box affine transform).
+static inline __m128i transform(__m128i x, __m128i lo, __m128i hi)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    return _mm_xor_si128(pshufb(lo, _mm_and_si128(x, mask)), pshufb(hi, _mm_and_si128(_mm_srli_epi16(x, 4), mask)));
+}
+
+
+// Inversion in the tower field, returns two nibble indexes for the output tables.
+static inline void inverse(__m128i t, __m128i &io, __m128i &jo)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i inv  = lut(0x80, 0x01, 0x09, 0x0E, 0x0D, 0x0B, 0x07, 0x06, 0x0F, 0x02, 0x0C, 0x05, 0x0A, 0x04, 0x03, 0x08);
+    const __m128i ak   = lut(0x80, 0x0F, 0x0E, 0x05, 0x07, 0x03, 0x0B, 0x04, 0x0A, 0x0D, 0x08, 0x06, 0x0C, 0x09, 0x02, 0x01);
+
+    const __m128i i    = _mm_and_si128(_mm_srli_epi16(t, 4), mask);
+    const __m128i k    = _mm_and_si128(t, mask);
+    const __m128i j    = _mm_xor_si128(i, k);
+    const __m128i a    = pshufb(ak, k);
+    const __m128i iak  = _mm_xor_si128(pshufb(inv, i), a);
+    const __m128i jak  = _mm_xor_si128(pshufb(inv, j), a);
+
+    io = _mm_xor_si128(pshufb(inv, iak), j);
+    jo = _mm_xor_si128(pshufb(inv, jak), i);
+}
+
+
+static inline __m128i output(__m128i io, __m128i jo, __m128i lo, __m128i hi)
+{
+    return _mm_xor_si128(pshufb(lo, io), pshufb(hi, jo));
+}
+
+
+static inline __m128i rot1(__m128i x) { return pshufb(x, lut(0x01, 0x02, 0x03, 0x00, 0x05, 0x06, 0x07, 0x04, 0x09, 0x0A, 0x0B, 0x08, 0x0D, 0x0E, 0x0F, 0x0C)); }
+static inline __m128i rot2(__m128i x) { return _mm_shufflelo_epi16(_mm_shufflehi_epi16(x, 0xB1), 0xB1); }
+static inline __m128i rot3(__m128i x) { return pshufb(x, lut(0x03, 0x00, 0x01, 0x02, 0x07, 0x04, 0x05, 0x06, 0x0B, 0x08, 0x09, 0x0A, 0x0F, 0x0C, 0x0D, 0x0E)); }
+
+
+} // namespace vperm
+
+
+// Same result as _mm_aesenc_si128(in, key).
+static inline __m128i vperm_aesenc(__m128i in, __m128i key)
+{
+    using namespace vperm;
+
+    const __m128i x = pshufb(in, lut(0x00, 0x05, 0x0A, 0x0F, 0x04, 0x09, 0x0E, 0x03, 0x08, 0x0D, 0x02, 0x07, 0x0C, 0x01, 0x06, 0x0B));
+    const __m128i t = transform(x, lut(0x00, 0x10, 0x02, 0x12, 0x64, 0x74, 0x66, 0x76, 0xC4, 0xD4, 0xC6, 0xD6, 0xA0, 0xB0, 0xA2, 0xB2),
+                                   lut(0x00, 0xC3, 0x5D, 0x9E, 0x43, 0x80, 0x1E, 0xDD, 0x5E, 0x9D, 0x03, 0xC0, 0x1D, 0xDE, 0x40, 0x83));
+
+    __m128i io, jo;
+    inverse(t, io, jo);
+
+    const __m128i a = output(io, jo, lut(0x00, 0x64, 0x99, 0x12, 0xE5, 0x0A, 0x8B, 0xEF, 0x76, 0x93, 0x81, 0x18, 0x6E, 0x7C, 0xF7, 0xFD),
+                                     lut(0x00, 0x7B, 0xB0, 0x3D, 0x67, 0x91, 0x8D, 0xF6, 0x46, 0x21, 0x1C, 0xAC, 0xEA, 0xD7, 0x5A, 0xCB));
+    const __m128i b = output(io, jo, lut(0x00, 0xC8, 0x29, 0x24, 0xD1, 0x14, 0x0D, 0xC5, 0xEC, 0x3D, 0x19, 0x30, 0xDC, 0xF8, 0xF5, 0xE1),
+                                     lut(0x00, 0xF6, 0x7B, 0x7A, 0xCE, 0x39, 0x01, 0xF7, 0x8C, 0x42, 0x38, 0x43, 0xCF, 0xB5, 0xB4, 0x8D));
+
+    __m128i out = _mm_xor_si128(b, rot1(_mm_xor_si128(a, b)));
+    out = _mm_xor_si128(out, _mm_xor_si128(rot2(a), rot3(a)));
+
+    return _mm_xor_si128(out, _mm_xor_si128(key, _mm_set1_epi8(0x63)));
+}
+
+
+// Same result as _mm_aesdec_si128(in, key).
+static inline __m128i vperm_aesdec(__m128i in, __m128i key)
+{
+    using namespace vperm;
+
+    const __m128i x = pshufb(in, lut(0x00, 0x0D, 0x0A, 0x07, 0x04, 0x01, 0x0E, 0x0B, 0x08, 0x05, 0x02, 0x0F, 0x0C, 0x09, 0x06, 0x03));
+    const __m128i t = transform(x, lut(0x74, 0xF1, 0x8D, 0x08, 0xFD, 0x78, 0x04, 0x81, 0xF6, 0x73, 0x0F, 0x8A, 0x7F, 0xFA, 0x86, 0x03),
+                                   lut(0x00, 0x67, 0x97, 0xF0, 0x9F, 0xF8, 0x08, 0x6F, 0x29, 0x4E, 0xBE, 0xD9, 0xB6, 0xD1, 0x21, 0x46));
+
+    __m128i io, jo;
+    inverse(t, io, jo);
+
+    const __m128i e = output(io, jo, lut(0x00, 0xCB, 0xDF, 0x3B, 0xE7, 0xC8, 0xE4, 0x2F, 0xF0, 0x17, 0x2C, 0xF3, 0x03, 0x38, 0xDC, 0x14),
+                                     lut(0x00, 0xC5, 0x9C, 0x44, 0x93, 0x8E, 0xD8, 0x1D, 0x81, 0x12, 0x56, 0xCA, 0x4B, 0x0F, 0xD7, 0x59));
+    const __m128i b = output(io, jo, lut(0x00, 0xDC, 0x14, 0xCB, 0x38, 0x3B, 0xDF, 0x03, 0x17, 0x2F, 0xE4, 0xF0, 0xE7, 0x2C, 0xF3, 0xC8),
+                                     lut(0x00, 0xD7, 0x59, 0xC5, 0x0F, 0x44, 0x9C, 0x4B, 0x12, 0x1D, 0xD8, 0x81, 0x93, 0x56, 0xCA, 0x8E));
+    const __m128i d = output(io, jo, lut(0x00, 0xC6, 0x6F, 0x6B, 0x5B, 0x99, 0x04, 0xC2, 0xAD, 0xF6, 0x9D, 0xF2, 0x5F, 0x34, 0x30, 0xA9),
+                                     lut(0x00, 0xCB, 0xDF, 0x3B, 0xE7, 0xC8, 0xE4, 0x2F, 0xF0, 0x17, 0x2C, 0xF3, 0x03, 0x38, 0xDC, 0x14));
+    const __m128i n = output(io, jo, lut(0x00, 0x23, 0x3D, 0xAB, 0x19, 0xAC, 0x96, 0xB5, 0x88, 0x91, 0x3A, 0x07, 0x8F, 0x24, 0xB2, 0x1E),
+                                     lut(0x00, 0x2A, 0xD2, 0x66, 0x57, 0xC9, 0xB4, 0x9E, 0x4C, 0x1B, 0x7D, 0xAF, 0xE3, 0x85, 0x31, 0xF8));
+
+    __m128i out = _mm_xor_si128(e, rot1(b));
+    out = _mm_xor_si128(out, _mm_xor_si128(rot2(d), rot3(n)));
+
+    return _mm_xor_si128(out, key);
+}
+
+
+// SubBytes without ShiftRows, used for the key schedule.
+static inline __m128i vperm_subbytes(__m128i in)
+{
+    using namespace vperm;
+
+    const __m128i t = transform(in, lut(0x00, 0x10, 0x02, 0x12, 0x64, 0x74, 0x66, 0x76, 0xC4, 0xD4, 0xC6, 0xD6, 0xA0, 0xB0, 0xA2, 0xB2),
+                                    lut(0x00, 0xC3, 0x5D, 0x9E, 0x43, 0x80, 0x1E, 0xDD, 0x5E, 0x9D, 0x03, 0xC0, 0x1D, 0xDE, 0x40, 0x83));
+
+    __m128i io, jo;
+    inverse(t, io, jo);
+
+    return _mm_xor_si128(output(io, jo, lut(0x00, 0x64, 0x99, 0x12, 0xE5, 0x0A, 0x8B, 0xEF, 0x76, 0x93, 0x81, 0x18, 0x6E, 0x7C, 0xF7, 0xFD),
+                                        lut(0x00, 0x7B, 0xB0, 0x3D, 0x67, 0x91, 0x8D, 0xF6, 0x46, 0x21, 0x1C, 0xAC, 0xEA, 0xD7, 0x5A, 0xCB)),
+                         _mm_set1_epi8(0x63));
+}
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_VPERMAES_H */
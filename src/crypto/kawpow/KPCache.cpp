@@ -27,15 +27,41 @@
 #include "3rdparty/libethash/ethash.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/tools/Baton.h"
 #include "base/tools/Chrono.h"
 #include "crypto/common/VirtualMemory.h"
 
 
+#include <mutex>
+#include <uv.h>
+
+
 namespace xmrig {
 
 
-std::mutex KPCache::s_cacheMutex;
-KPCache KPCache::s_cache;
+// Two slots indexed by epoch parity: the current epoch and the one built ahead of time.
+static constexpr size_t kSlots = 2;
+
+static KPCache::Ptr slots[kSlots];
+static std::mutex buildMutex;
+static uint32_t preparedEpoch = 0xFFFFFFFFUL;
+
+
+class KPCacheBaton : public Baton<uv_work_t>
+{
+public:
+    inline KPCacheBaton(uint32_t epoch) : epoch(epoch) {}
+
+    const uint32_t epoch;
+};
+
+
+static inline KPCache::Ptr lookup(uint32_t epoch)
+{
+    auto cache = std::atomic_load(&slots[epoch % kSlots]);
+
+    return (cache && cache->epoch() == epoch) ? cache : KPCache::Ptr();
+}
 
 
 KPCache::KPCache()
@@ -112,6 +138,59 @@ bool KPCache::init(uint32_t epoch)
 }
 
 
+KPCache::Ptr KPCache::get(uint32_t epoch)
+{
+    auto cache = lookup(epoch);
+
+    return cache ? cache : build(epoch);
+}
+
+
+void KPCache::prepare(uint32_t epoch)
+{
+    if (epoch == preparedEpoch || epoch >= sizeof(cache_sizes) / sizeof(cache_sizes[0])) {
+        return;
+    }
+
+    preparedEpoch = epoch;
+
+    auto baton = new KPCacheBaton(epoch);
+
+    uv_queue_work(uv_default_loop(), &baton->req,
+        [](uv_work_t *req) {
+            auto baton = static_cast<KPCacheBaton*>(req->data);
+
+            build(baton->epoch);
+            build(baton->epoch + 1);
+        },
+        [](uv_work_t *req, int) {
+            delete static_cast<KPCacheBaton*>(req->data);
+        }
+    );
+}
+
+
+KPCache::Ptr KPCache::build(uint32_t epoch)
+{
+    std::lock_guard<std::mutex> lock(buildMutex);
+
+    auto cache = lookup(epoch);
+    if (cache) {
+        return cache;
+    }
+
+    std::shared_ptr<KPCache> fresh = std::make_shared<KPCache>();
+    if (!fresh->init(epoch)) {
+        return {};
+    }
+
+    cache = fresh;
+    std::atomic_store(&slots[epoch % kSlots], cache);
+
+    return cache;
+}
+
+
 void* KPCache::data() const
 {
     return m_memory ? m_memory->raw() : nullptr;
@@ -21,7 +21,7 @@
 
 
 #include "base/tools/Object.h"
-#include <mutex>
+#include <memory>
 #include <vector>
 
 
@@ -39,6 +39,8 @@ public:
     static constexpr size_t l1_cache_num_items = l1_cache_size / sizeof(uint32_t);
     static constexpr uint32_t num_dataset_parents = 512;
 
+    using Ptr = std::shared_ptr<const KPCache>;
+
     XMRIG_DISABLE_COPY_MOVE(KPCache)
 
     KPCache();
@@ -57,10 +59,15 @@ public:
 
     static void calculate_fast_mod_data(uint32_t divisor, uint32_t &reciprocal, uint32_t &increment, uint32_t& shift);
 
-    static std::mutex s_cacheMutex;
-    static KPCache s_cache;
+    // Published caches are immutable, get() is lock-free when the epoch is ready and builds it otherwise.
+    static Ptr get(uint32_t epoch);
+
+    // Must be called from the main loop, builds the epoch and the next one on the libuv thread pool.
+    static void prepare(uint32_t epoch);
 
 private:
+    static Ptr build(uint32_t epoch);
+
     VirtualMemory* m_memory = nullptr;
     size_t m_size = 0;
     uint32_t m_epoch = 0xFFFFFFFFUL;
@@ -33,12 +33,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef void (hashAndFillAes1Rx4_impl)(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
 
 extern hashAndFillAes1Rx4_impl* softAESImpl;
+extern bool softAESVperm;
 
 inline hashAndFillAes1Rx4_impl* GetSoftAESImpl()
 {
   return softAESImpl;
 }
 
+// true if SelectSoftAESImpl picked the SSSE3 vector permute AES (softAes = 3), the other AES functions should use it too
+inline bool IsSoftAESVperm()
+{
+  return softAESVperm;
+}
+
 void SelectSoftAESImpl(size_t threadsCount);
 
 template<int softAes>
@@ -52,3 +59,13 @@ void fillAes4Rx4(void *state, size_t outputSize, void *buffer);
 
 template<int softAes, int unroll>
 void hashAndFillAes1Rx4(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
+
+#ifdef XMRIG_FEATURE_SSSE3
+// Instantiated in aes_hash_vperm.cpp, the only translation unit compiled with SSSE3
+extern template void hashAes1Rx4<3>(const void *input, size_t inputSize, void *hash);
+extern template void fillAes1Rx4<3>(void *state, size_t outputSize, void *buffer);
+extern template void fillAes4Rx4<3>(void *state, size_t outputSize, void *buffer);
+extern template void hashAndFillAes1Rx4<3,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+extern template void hashAndFillAes1Rx4<3,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+extern template void hashAndFillAes1Rx4<3,4>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+#endif
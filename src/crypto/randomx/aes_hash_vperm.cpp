@@ -0,0 +1,29 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/randomx/aes_hash.hpp"
+#include "crypto/randomx/aes_hash_impl.hpp"
+
+
+// Vector permute soft AES (softAes = 3), this file is compiled with -mssse3.
+template void hashAes1Rx4<3>(const void *input, size_t inputSize, void *hash);
+template void fillAes1Rx4<3>(void *state, size_t outputSize, void *buffer);
+template void fillAes4Rx4<3>(void *state, size_t outputSize, void *buffer);
+template void hashAndFillAes1Rx4<3,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<3,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<3,4>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
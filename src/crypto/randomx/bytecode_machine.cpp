@@ -78,6 +78,134 @@ namespace randomx {
 		}
 	}
 
+#if defined(__GNUC__)
+#	define RANDOMX_THREADED_DISPATCH
+#endif
+
+	std::atomic<bool> BytecodeMachine::threadedDispatch{ true };
+
+#ifdef RANDOMX_THREADED_DISPATCH
+#define FUSABLE_FIRST(M) M(IADD_RS) M(ISUB_R) M(IXOR_R) M(IMUL_R) M(FADD_R) M(FSUB_R) M(FMUL_R)
+#define FUSABLE_SECOND(M, a) M(a, IADD_RS) M(a, ISUB_R) M(a, IXOR_R) M(a, IMUL_R) M(a, FADD_R) M(a, FSUB_R) M(a, FMUL_R)
+
+	constexpr int FusableCount = 7;
+	constexpr int FusedBase = static_cast<int>(InstructionType::NOP) + 1;
+
+	static_assert(static_cast<int>(InstructionType::NOP) == 29, "InstructionType mismatch");
+
+	static int fusableIndex(InstructionType type) {
+		int index = 0;
+#define FUSABLE_INDEX(x) if (type == InstructionType::x) return index; ++index;
+		FUSABLE_FIRST(FUSABLE_INDEX)
+#undef FUSABLE_INDEX
+		return -1;
+	}
+
+	void BytecodeMachine::runThreaded(InstructionByteCode* bytecode, ThreadedHandler* handlers, uint8_t* scratchpad, ProgramConfiguration* config) {
+#define FUSED_LABEL(a, b) &&op_ ## a ## _ ## b,
+#define FUSED_LABEL_ROW(a) FUSABLE_SECOND(FUSED_LABEL, a)
+		static const ThreadedHandler labels[] = {
+			&&op_IADD_RS, &&op_IADD_M, &&op_ISUB_R, &&op_ISUB_M, &&op_IMUL_R, &&op_IMUL_M, &&op_IMULH_R, &&op_IMULH_M,
+			&&op_ISMULH_R, &&op_ISMULH_M, &&op_IMUL_R, &&op_INEG_R, &&op_IXOR_R, &&op_IXOR_M, &&op_IROR_R, &&op_IROL_R,
+			&&op_ISWAP_R, &&op_FSWAP_R, &&op_FADD_R, &&op_FADD_M, &&op_FSUB_R, &&op_FSUB_M, &&op_FSCAL_R, &&op_FMUL_R,
+			&&op_FDIV_M, &&op_FSQRT_R, &&op_CBRANCH, &&op_CFROUND, &&op_ISTORE, &&op_NOP,
+			FUSABLE_FIRST(FUSED_LABEL_ROW)
+		};
+#undef FUSED_LABEL_ROW
+#undef FUSED_LABEL
+
+		const int size = static_cast<int>(RandomX_CurrentConfig.ProgramSize);
+
+		if (!scratchpad) {
+			for (int i = 0; i < size; ++i) {
+				handlers[i] = labels[static_cast<int>(bytecode[i].type)];
+			}
+
+			//a branch into the second instruction of a pair still finds its own handler there
+			for (int i = 0; i + 1 < size; ++i) {
+				const int first = fusableIndex(bytecode[i].type);
+				const int second = fusableIndex(bytecode[i + 1].type);
+				if (first >= 0 && second >= 0) {
+					handlers[i] = labels[FusedBase + first * FusableCount + second];
+					++i;
+				}
+			}
+
+			//label addresses stay valid after return, silence the false positive
+#			if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 12)
+#			pragma GCC diagnostic push
+#			pragma GCC diagnostic ignored "-Wdangling-pointer"
+#			endif
+			handlers[size] = &&op_end;
+#			if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 12)
+#			pragma GCC diagnostic pop
+#			endif
+			return;
+		}
+
+		int pc = 0;
+
+#define DISPATCH() goto *handlers[pc]
+#define THREADED_OP(x) op_ ## x: exe_ ## x(bytecode[pc], pc, scratchpad, *config); ++pc; DISPATCH();
+#define FUSED_OP(a, b) op_ ## a ## _ ## b: exe_ ## a(bytecode[pc], pc, scratchpad, *config); exe_ ## b(bytecode[pc + 1], pc, scratchpad, *config); pc += 2; DISPATCH();
+#define FUSED_OP_ROW(a) FUSABLE_SECOND(FUSED_OP, a)
+
+		DISPATCH();
+
+		THREADED_OP(IADD_RS)
+		THREADED_OP(IADD_M)
+		THREADED_OP(ISUB_R)
+		THREADED_OP(ISUB_M)
+		THREADED_OP(IMUL_R)
+		THREADED_OP(IMUL_M)
+		THREADED_OP(IMULH_R)
+		THREADED_OP(IMULH_M)
+		THREADED_OP(ISMULH_R)
+		THREADED_OP(ISMULH_M)
+		THREADED_OP(INEG_R)
+		THREADED_OP(IXOR_R)
+		THREADED_OP(IXOR_M)
+		THREADED_OP(IROR_R)
+		THREADED_OP(IROL_R)
+		THREADED_OP(ISWAP_R)
+		THREADED_OP(FSWAP_R)
+		THREADED_OP(FADD_R)
+		THREADED_OP(FADD_M)
+		THREADED_OP(FSUB_R)
+		THREADED_OP(FSUB_M)
+		THREADED_OP(FSCAL_R)
+		THREADED_OP(FMUL_R)
+		THREADED_OP(FDIV_M)
+		THREADED_OP(FSQRT_R)
+		THREADED_OP(CBRANCH)
+		THREADED_OP(CFROUND)
+		THREADED_OP(ISTORE)
+
+		FUSABLE_FIRST(FUSED_OP_ROW)
+
+	op_NOP:
+		++pc;
+		DISPATCH();
+
+	op_end:
+		return;
+
+#undef FUSED_OP_ROW
+#undef FUSED_OP
+#undef THREADED_OP
+#undef DISPATCH
+	}
+
+#undef FUSABLE_SECOND
+#undef FUSABLE_FIRST
+#else
+	void BytecodeMachine::runThreaded(InstructionByteCode* bytecode, ThreadedHandler*, uint8_t* scratchpad, ProgramConfiguration* config) {
+		if (scratchpad) {
+			executeBytecode(bytecode, scratchpad, *config);
+		}
+	}
+#endif
+
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		uint32_t opcode = instr.opcode;
 
@@ -508,3 +636,7 @@ namespace randomx {
 		UNREACHABLE;
 	}
 }
+
+void randomx_set_threaded_interpreter(bool enabled) {
+	randomx::BytecodeMachine::threadedDispatch.store(enabled, std::memory_order_relaxed);
+}
@@ -33,6 +33,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/instruction.hpp"
 #include "crypto/randomx/program.hpp"
 
+#include <atomic>
+
 namespace randomx {
 
 	//register file in machine byte order
@@ -70,6 +72,7 @@ namespace randomx {
 	class BytecodeMachine;
 
 	typedef void(BytecodeMachine::*InstructionGenBytecode)(RANDOMX_GEN_ARGS);
+	typedef const void* ThreadedHandler;
 
 	class BytecodeMachine {
 	public:
@@ -96,6 +99,19 @@ namespace randomx {
 			}
 		}
 
+		//threaded code: every instruction gets the address of its handler, two adjacent register-register
+		//instructions share a fused handler, handlers jump directly to the next one (computed goto)
+		static void compileThreaded(InstructionByteCode* bytecode, ThreadedHandler* handlers) {
+			runThreaded(bytecode, handlers, nullptr, nullptr);
+		}
+
+		static void executeThreaded(InstructionByteCode* bytecode, ThreadedHandler* handlers, uint8_t* scratchpad, ProgramConfiguration& config) {
+			runThreaded(bytecode, handlers, scratchpad, &config);
+		}
+
+		//set from the main thread, read by the mining threads once per program
+		static std::atomic<bool> threadedDispatch;
+
 		void compileInstruction(RANDOMX_GEN_ARGS)
 #ifdef RANDOMX_GEN_TABLE
 		{
@@ -245,6 +261,8 @@ namespace randomx {
 		int registerUsage[RegistersCount];
 		NativeRegisterFile* nreg;
 
+		static void runThreaded(InstructionByteCode* bytecode, ThreadedHandler* handlers, uint8_t* scratchpad, ProgramConfiguration* config);
+
 		static void* getScratchpadAddress(InstructionByteCode& ibc, uint8_t* scratchpad) {
 			uint32_t addr = (*ibc.isrc + ibc.imm) & ibc.memMask;
 			return scratchpad + addr;
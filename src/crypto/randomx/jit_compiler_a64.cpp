@@ -112,7 +112,12 @@ JitCompilerA64::JitCompilerA64(bool hugePagesEnable, bool) :
 
 JitCompilerA64::~JitCompilerA64()
 {
-	freePagedMemory(code, allocatedSize);
+	if (isDualMapped()) {
+		xmrig::VirtualMemory::freeDualMappedMemory(code, execCode, allocatedSize);
+	}
+	else {
+		freePagedMemory(code, allocatedSize);
+	}
 }
 
 void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& config, uint32_t)
@@ -171,7 +176,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	emit32(ARMV8A::EOR | 10 | (IntRegMap[config.readReg0] << 5) | (IntRegMap[config.readReg1] << 16), code, codePos);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + MainLoopBegin), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(execCode + MainLoopBegin), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -237,7 +242,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	emit32(ARMV8A::ADD_IMM_HI | 2 | (2 << 5) | (imm_hi << 10), code, codePos);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + MainLoopBegin), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(execCode + MainLoopBegin), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -364,7 +369,7 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 	codePos += p2 - p1;
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code + CodeSize), codePos - MainLoopBegin);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(execCode + CodeSize), codePos - MainLoopBegin);
 #	endif
 }
 
@@ -376,7 +381,7 @@ DatasetInitFunc* JitCompilerA64::getDatasetInitFunc() const
 	enableExecution();
 #	endif
 
-	return (DatasetInitFunc*)(code + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
+	return (DatasetInitFunc*)(execCode + (((uint8_t*)randomx_init_dataset_aarch64) - ((uint8_t*)randomx_program_aarch64)));
 }
 
 size_t JitCompilerA64::getCodeSize()
@@ -386,11 +391,19 @@ size_t JitCompilerA64::getCodeSize()
 
 void JitCompilerA64::enableWriting() const
 {
+	if (isDualMapped()) {
+		return;
+	}
+
 	xmrig::VirtualMemory::protectRW(code, allocatedSize);
 }
 
 void JitCompilerA64::enableExecution() const
 {
+	if (isDualMapped()) {
+		return;
+	}
+
 	xmrig::VirtualMemory::protectRX(code, allocatedSize);
 }
 
@@ -398,12 +411,26 @@ void JitCompilerA64::enableExecution() const
 void JitCompilerA64::allocate(size_t size)
 {
 	allocatedSize = size;
+
+#	ifdef XMRIG_SECURE_JIT
+	// Prefer separate writable and executable views of the same pages, fall back to switching protection with mprotect
+	void* exec = nullptr;
+	code = static_cast<uint8_t*>(xmrig::VirtualMemory::allocateDualMappedMemory(allocatedSize, &exec));
+	execCode = static_cast<uint8_t*>(exec);
+
+	if (!code) {
+		code = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePages));
+		execCode = code;
+	}
+#	else
 	code = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePages));
+	execCode = code;
+#	endif
 
 	memcpy(code, reinterpret_cast<const void *>(randomx_program_aarch64), CodeSize);
 
 #	ifndef XMRIG_OS_APPLE
-	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(code), CodeSize);
+	xmrig::VirtualMemory::flushInstructionCache(reinterpret_cast<char*>(execCode), CodeSize);
 #	endif
 }
 
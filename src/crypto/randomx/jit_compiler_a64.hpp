@@ -53,6 +53,7 @@ namespace randomx {
 		void prepare() {}
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
+		void setPartialDataset(const uint8_t*, uint32_t) {}
 
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram(&programs)[N]);
@@ -64,7 +65,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return reinterpret_cast<ProgramFunc*>(code);
+			return reinterpret_cast<ProgramFunc*>(execCode);
 		}
 
 		DatasetInitFunc* getDatasetInitFunc() const;
@@ -80,10 +81,13 @@ namespace randomx {
 		const bool hugePages;
 		uint32_t reg_changed_offset[8]{};
 		uint8_t* code = nullptr;
+		uint8_t* execCode = nullptr;
 		uint32_t literalPos;
 		uint32_t num32bitLiterals = 0;
 		size_t allocatedSize = 0;
 
+		inline bool isDualMapped() const { return execCode != code; }
+
 		void allocate(size_t size);
 
 		static void emit32(uint32_t val, uint8_t* code, uint32_t& codePos)
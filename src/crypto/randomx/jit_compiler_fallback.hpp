@@ -52,6 +52,9 @@ namespace randomx {
 		}
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t) {
 
+		}
+		void setPartialDataset(const uint8_t*, uint32_t) {
+
 		}
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram(&programs)[N]) {
@@ -155,6 +155,20 @@ namespace randomx {
 
 	constexpr int32_t superScalarHashOffset = 32768;
 
+	static const uint8_t PARTIAL_DATASET_READ[] = {
+		0x89, 0xD9,             // mov ecx, ebx
+		0x48, 0xC1, 0xE1, 0x06, // shl rcx, 6
+		0x48, 0x01, 0xC8,       // add rax, rcx
+		0x4C, 0x8B, 0x00,       // mov r8, [rax]
+		0x4C, 0x8B, 0x48, 0x08, // mov r9, [rax+8]
+		0x4C, 0x8B, 0x50, 0x10, // mov r10, [rax+16]
+		0x4C, 0x8B, 0x58, 0x18, // mov r11, [rax+24]
+		0x4C, 0x8B, 0x60, 0x20, // mov r12, [rax+32]
+		0x4C, 0x8B, 0x68, 0x28, // mov r13, [rax+40]
+		0x4C, 0x8B, 0x70, 0x30, // mov r14, [rax+48]
+		0x4C, 0x8B, 0x78, 0x38, // mov r15, [rax+56]
+		0xEB, 0x05,             // jmp over the superscalar hash call
+	};
 	static const uint8_t NOP1[] = { 0x90 };
 	static const uint8_t NOP2[] = { 0x66, 0x90 };
 	static const uint8_t NOP3[] = { 0x66, 0x66, 0x90 };
@@ -195,12 +209,20 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::enableWriting() const {
+		if (isDualMapped()) {
+			return;
+		}
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRW(p1, p2 - p1);
 	}
 
 	void JitCompilerX86::enableExecution() const {
+		if (isDualMapped()) {
+			return;
+		}
+
 		uint8_t* p1 = alignToPage(code, 4096);
 		uint8_t* p2 = code + CodeSize;
 		xmrig::VirtualMemory::protectRX(p1, p2 - p1);
@@ -270,16 +292,26 @@ namespace randomx {
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
 		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
-		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
-#			ifdef XMRIG_SECURE_JIT
-			false
-#			else
-			hugePagesJIT && hugePagesEnable
-#			endif
-		));
+
+#		ifdef XMRIG_SECURE_JIT
+		// Prefer separate writable and executable views of the same pages, fall back to switching protection with mprotect
+		void* exec = nullptr;
+		allocatedCode = static_cast<uint8_t*>(xmrig::VirtualMemory::allocateDualMappedMemory(allocatedSize, &exec));
+		allocatedExecCode = static_cast<uint8_t*>(exec);
+
+		if (!allocatedCode) {
+			allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, false));
+			allocatedExecCode = allocatedCode;
+		}
+#		else
+		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize, hugePagesJIT && hugePagesEnable));
+		allocatedExecCode = allocatedCode;
+#		endif
 
 		// Shift code base address to improve caching - all threads will use different L2/L3 cache sets
-		code = allocatedCode + (codeOffset.fetch_add(codeOffsetIncrement) % CodeSize);
+		const size_t offset = codeOffset.fetch_add(codeOffsetIncrement) % CodeSize;
+		code = allocatedCode + offset;
+		execCode = allocatedExecCode + offset;
 
 		memcpy(code, codePrologue, prologueSize);
 		if (hasXOP) {
@@ -293,14 +325,20 @@ namespace randomx {
 		codePosFirst = prologueSize + (hasXOP ? loopLoadXOPSize : loopLoadSize);
 
 #		ifdef XMRIG_FIX_RYZEN
-		mainLoopBounds.first = code + prologueSize;
-		mainLoopBounds.second = code + epilogueOffset;
+		mainLoopBounds.first = execCode + prologueSize;
+		mainLoopBounds.second = execCode + epilogueOffset;
 #		endif
 	}
 
 	JitCompilerX86::~JitCompilerX86() {
 		codeOffset.fetch_sub(codeOffsetIncrement);
-		freePagedMemory(allocatedCode, allocatedSize);
+
+		if (isDualMapped()) {
+			xmrig::VirtualMemory::freeDualMappedMemory(allocatedCode, allocatedExecCode, allocatedSize);
+		}
+		else {
+			freePagedMemory(allocatedCode, allocatedSize);
+		}
 	}
 
 	void JitCompilerX86::prepare() {
@@ -330,6 +368,22 @@ namespace randomx {
 		*(uint32_t*)(code + codePos) = 0xc381;
 		codePos += 2;
 		emit32(datasetOffset / CacheLineSize, code, codePos);
+
+		if (partialDatasetItems) {
+			// cmp ebx, partialDatasetItems; jae to the call below
+			emitByte(0x81, code, codePos);
+			emitByte(0xfb, code, codePos);
+			emit32(partialDatasetItems, code, codePos);
+			emitByte(0x73, code, codePos);
+			emitByte(10 + sizeof(PARTIAL_DATASET_READ), code, codePos);
+
+			// mov rax, partialDataset
+			emitByte(0x48, code, codePos);
+			emitByte(0xb8, code, codePos);
+			emit64(reinterpret_cast<uint64_t>(partialDataset), code, codePos);
+			emit(PARTIAL_DATASET_READ, code, codePos);
+		}
+
 		emitByte(0xe8, code, codePos);
 		emit32(superScalarHashOffset - (codePos + 4), code, codePos);
 		emit(codeReadDatasetLightSshFin, readDatasetLightFinSize, code, codePos);
@@ -54,6 +54,12 @@ namespace randomx {
 		void prepare();
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
 		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
+
+		inline void setPartialDataset(const uint8_t* memory, uint32_t items) {
+			partialDataset = memory;
+			partialDatasetItems = items;
+		}
+
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram (&programs)[N]);
 		void generateDatasetInitCode();
@@ -63,7 +69,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return reinterpret_cast<ProgramFunc*>(code);
+			return reinterpret_cast<ProgramFunc*>(execCode);
 		}
 
 		inline DatasetInitFunc *getDatasetInitFunc() const {
@@ -71,7 +77,7 @@ namespace randomx {
 			enableExecution();
 #			endif
 
-			return (DatasetInitFunc*)code;
+			return (DatasetInitFunc*)execCode;
 		}
 
 		uint8_t* getCode() {
@@ -86,10 +92,13 @@ namespace randomx {
 	private:
 		int registerUsage[RegistersCount] = {};
 		uint8_t* code = nullptr;
+		uint8_t* execCode = nullptr;
 		uint32_t codePos = 0;
 		uint32_t codePosFirst = 0;
 		uint32_t vm_flags = 0;
 		uint32_t prevCFROUND = 0;
+		uint32_t partialDatasetItems = 0;
+		const uint8_t* partialDataset = nullptr;
 
 #		ifdef XMRIG_FIX_RYZEN
 		std::pair<const void*, const void*> mainLoopBounds;
@@ -102,8 +111,11 @@ namespace randomx {
 		bool hasXOP;
 
 		uint8_t* allocatedCode = nullptr;
+		uint8_t* allocatedExecCode = nullptr;
 		size_t allocatedSize = 0;
 
+		inline bool isDualMapped() const { return allocatedExecCode != allocatedCode; }
+
 		uint8_t* imul_rcp_storage = nullptr;
 		uint32_t imul_rcp_storage_used = 0;
 
@@ -174,18 +174,6 @@ RandomX_ConfigurationBase::RandomX_ConfigurationBase()
 		const uint8_t* b = addr(randomx_sshash_end);
 		memcpy(codeSshPrefetchTweaked, a, b - a);
 	}
-	if (xmrig::Cpu::info()->hasBMI2()) {
-		const uint8_t* a = addr(randomx_prefetch_scratchpad_bmi2);
-		const uint8_t* b = addr(randomx_prefetch_scratchpad_end);
-		memcpy(codePrefetchScratchpadTweaked, a, b - a);
-		codePrefetchScratchpadTweakedSize = b - a;
-	}
-	else {
-		const uint8_t* a = addr(randomx_prefetch_scratchpad);
-		const uint8_t* b = addr(randomx_prefetch_scratchpad_bmi2);
-		memcpy(codePrefetchScratchpadTweaked, a, b - a);
-		codePrefetchScratchpadTweakedSize = b - a;
-	}
 #	endif
 }
 
@@ -221,8 +209,27 @@ void RandomX_ConfigurationBase::Apply()
 	//*(uint32_t*)(codeReadDatasetTweaked + 24) = DatasetBaseMask;
 	//*(uint32_t*)(codeReadDatasetLightSshInitTweaked + 59) = DatasetBaseMask;
 
+	// CPU info is not queried from the constructor, configurations are static objects and the topology
+	// probe must not run before the config is loaded.
 	const bool hasBMI2 = xmrig::Cpu::info()->hasBMI2();
 
+	auto addr = [](void (*func)()) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(func);
+#		if defined(_MSC_VER)
+		if (p[0] == 0xE9) {
+			p += *(const int32_t*)(p + 1) + 5;
+		}
+#		endif
+		return p;
+	};
+
+	{
+		const uint8_t* a = addr(hasBMI2 ? randomx_prefetch_scratchpad_bmi2 : randomx_prefetch_scratchpad);
+		const uint8_t* b = addr(hasBMI2 ? randomx_prefetch_scratchpad_end : randomx_prefetch_scratchpad_bmi2);
+		memcpy(codePrefetchScratchpadTweaked, a, b - a);
+		codePrefetchScratchpadTweakedSize = b - a;
+	}
+
 	*(uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 7 : 4)) = ScratchpadL3Mask64_Calculated;
 	*(uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 17 : 18)) = ScratchpadL3Mask64_Calculated;
 
@@ -560,6 +567,12 @@ extern "C" {
 		machine->setDataset(dataset);
 	}
 
+	void randomx_vm_set_partial_dataset(randomx_vm *machine, const void *memory, unsigned long itemCount) {
+		assert(machine != nullptr);
+		assert(itemCount == 0 || memory != nullptr);
+		machine->setPartialDataset(static_cast<const uint8_t*>(memory), itemCount);
+	}
+
 	void randomx_destroy_vm(randomx_vm* vm) {
 		vm->~randomx_vm();
 	}
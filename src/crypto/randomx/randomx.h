@@ -170,6 +170,13 @@ void randomx_set_scratchpad_prefetch_mode(int mode);
 void randomx_set_huge_pages_jit(bool hugePages);
 void randomx_set_optimized_dataset_init(int value);
 
+// Interpreter dispatch when the JIT is not used: threaded code (default) or the original switch loop.
+void randomx_set_threaded_interpreter(bool enabled);
+
+// Accumulates the time spent in program generation and JIT compilation vs. the whole hash while enabled, enabling resets the counters.
+void randomx_set_jit_stats(bool enabled);
+void randomx_get_jit_stats(uint64_t *compileTime, uint64_t *totalTime);
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -296,6 +303,17 @@ RANDOMX_EXPORT void randomx_vm_set_cache(randomx_vm *machine, randomx_cache* cac
 */
 RANDOMX_EXPORT void randomx_vm_set_dataset(randomx_vm *machine, randomx_dataset *dataset);
 
+/**
+ * Attaches a partially initialized Dataset to a light mode virtual machine. Items with
+ * a number below itemCount are read from memory, the rest is computed from the Cache.
+ *
+ * @param machine is a pointer to a randomx_vm structure that was initialized
+ *        without RANDOMX_FLAG_FULL_MEM. Must not be NULL.
+ * @param memory is a pointer to the first itemCount Dataset items. Can be NULL if itemCount is 0.
+ * @param itemCount is the number of initialized items.
+*/
+RANDOMX_EXPORT void randomx_vm_set_partial_dataset(randomx_vm *machine, const void *memory, unsigned long itemCount);
+
 /**
  * Releases all memory occupied by the randomx_vm structure.
  *
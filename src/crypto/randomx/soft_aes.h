@@ -32,6 +32,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include "crypto/randomx/intrin_portable.h"
 
+#if defined(XMRIG_FEATURE_SSSE3) && (defined(__SSSE3__) || defined(_MSC_VER))
+#   include "crypto/common/VpermAes.h"
+#endif
+
 extern uint32_t lutEnc0[256];
 extern uint32_t lutEnc1[256];
 extern uint32_t lutEnc2[256];
@@ -147,3 +151,15 @@ template<>
 FORCE_INLINE rx_vec_i128 aesdec<0>(rx_vec_i128 in, rx_vec_i128 key) {
 	return rx_aesdec_vec_i128(in, key);
 }
+
+#if defined(XMRIG_FEATURE_SSSE3) && (defined(__SSSE3__) || defined(_MSC_VER))
+template<>
+FORCE_INLINE rx_vec_i128 aesenc<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	return xmrig::vperm_aesenc(in, key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesdec<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	return xmrig::vperm_aesdec(in, key);
+}
+#endif
@@ -112,6 +112,12 @@ namespace randomx {
 
 	template<int softAes>
 	void VmBase<softAes>::getFinalResult(void* out) {
+#		ifdef XMRIG_FEATURE_SSSE3
+		if (softAes && IsSoftAESVperm()) {
+			hashAes1Rx4<3>(scratchpad, ScratchpadSize, &reg.a);
+		}
+		else
+#		endif
 		hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
 		rx_blake2b_wrapper::run(out, RANDOMX_HASH_SIZE, &reg, sizeof(RegisterFile));
 	}
@@ -130,12 +136,24 @@ namespace randomx {
 
 	template<int softAes>
 	void VmBase<softAes>::initScratchpad(void* seed) {
+#		ifdef XMRIG_FEATURE_SSSE3
+		if (softAes && IsSoftAESVperm()) {
+			fillAes1Rx4<3>(seed, ScratchpadSize, scratchpad);
+			return;
+		}
+#		endif
 		fillAes1Rx4<softAes>(seed, ScratchpadSize, scratchpad);
 	}
 
 	template<int softAes>
 	void VmBase<softAes>::generateProgram(void* seed) {
 		PROFILE_SCOPE(RandomX_generate_program);
+#		ifdef XMRIG_FEATURE_SSSE3
+		if (softAes && IsSoftAESVperm()) {
+			fillAes4Rx4<3>(seed, 128 + RandomX_CurrentConfig.ProgramSize * 8, &program);
+			return;
+		}
+#		endif
 		fillAes4Rx4<softAes>(seed, 128 + RandomX_CurrentConfig.ProgramSize * 8, &program);
 	}
 
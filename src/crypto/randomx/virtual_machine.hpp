@@ -49,6 +49,11 @@ public:
 	void setFlags(uint32_t flags) { vm_flags = flags; }
 	uint32_t getFlags() const { return vm_flags; }
 
+	void setPartialDataset(const uint8_t* memory, uint32_t items) {
+		partialDataset = memory;
+		partialDatasetItems = items;
+	}
+
 	randomx::RegisterFile *getRegisterFile() {
 		return &reg;
 	}
@@ -75,6 +80,8 @@ protected:
 	};
 	uint64_t datasetOffset;
 	uint32_t vm_flags;
+	uint32_t partialDatasetItems = 0;
+	const uint8_t* partialDataset = nullptr;
 };
 
 namespace randomx {
@@ -32,6 +32,24 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/common.hpp"
 #include "crypto/rx/Profiler.h"
 
+#include <atomic>
+#include <chrono>
+
+static std::atomic<bool> jitStats{ false };
+static std::atomic<uint64_t> jitCompileTime{ 0 };
+static std::atomic<uint64_t> jitTotalTime{ 0 };
+
+void randomx_set_jit_stats(bool enabled) {
+	jitCompileTime.store(0, std::memory_order_relaxed);
+	jitTotalTime.store(0, std::memory_order_relaxed);
+	jitStats.store(enabled, std::memory_order_relaxed);
+}
+
+void randomx_get_jit_stats(uint64_t *compileTime, uint64_t *totalTime) {
+	*compileTime = jitCompileTime.load(std::memory_order_relaxed);
+	*totalTime   = jitTotalTime.load(std::memory_order_relaxed);
+}
+
 namespace randomx {
 
 	static_assert(sizeof(MemoryRegisters) == 2 * sizeof(addr_t) + sizeof(uintptr_t), "Invalid alignment of struct randomx::MemoryRegisters");
@@ -46,11 +64,26 @@ namespace randomx {
 	void CompiledVm<softAes>::run(void* seed) {
 		PROFILE_SCOPE(RandomX_run);
 
+		using clock = std::chrono::steady_clock;
+		const bool stats = jitStats.load(std::memory_order_relaxed);
+		const clock::time_point start = stats ? clock::now() : clock::time_point();
+
 		compiler.prepare();
 		VmBase<softAes>::generateProgram(seed);
 		randomx_vm::initialize();
 		compiler.generateProgram(program, config, randomx_vm::getFlags());
 		mem.memory = datasetPtr->memory + datasetOffset;
+
+		if (stats) {
+			const clock::time_point compiled = clock::now();
+			execute();
+
+			jitCompileTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(compiled - start).count(), std::memory_order_relaxed);
+			jitTotalTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count(), std::memory_order_relaxed);
+
+			return;
+		}
+
 		execute();
 	}
 
@@ -55,6 +55,7 @@ namespace randomx {
 		compiler.enableWriting();
 #		endif
 
+		compiler.setPartialDataset(partialDataset, partialDatasetItems);
 		compiler.generateProgramLight(program, config, datasetOffset);
 
 		CompiledVm<softAes>::execute();
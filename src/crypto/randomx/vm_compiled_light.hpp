@@ -50,6 +50,8 @@ namespace randomx {
 		using CompiledVm<softAes>::config;
 		using CompiledVm<softAes>::cachePtr;
 		using CompiledVm<softAes>::datasetOffset;
+		using CompiledVm<softAes>::partialDataset;
+		using CompiledVm<softAes>::partialDatasetItems;
 	};
 
 	using CompiledLightVmDefault = CompiledLightVm<1>;
@@ -56,6 +56,11 @@ namespace randomx {
 
 		compileProgram(program, bytecode, nreg);
 
+		const bool threaded = threadedDispatch.load(std::memory_order_relaxed);
+		if (threaded) {
+			compileThreaded(bytecode, handlers);
+		}
+
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
 
@@ -75,7 +80,12 @@ namespace randomx {
 			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
 
-			executeBytecode(bytecode, scratchpad, config);
+			if (threaded) {
+				executeThreaded(bytecode, handlers, scratchpad, config);
+			}
+			else {
+				executeBytecode(bytecode, scratchpad, config);
+			}
 
 			mem.mx ^= nreg.r[config.readReg2] ^ nreg.r[config.readReg3];
 			mem.mx &= CacheLineAlignMask;
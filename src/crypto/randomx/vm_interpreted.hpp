@@ -63,6 +63,7 @@ namespace randomx {
 		void execute();
 
 		InstructionByteCode bytecode[RANDOMX_PROGRAM_MAX_SIZE];
+		ThreadedHandler handlers[RANDOMX_PROGRAM_MAX_SIZE + 1];
 	};
 
 	using InterpretedVmDefault = InterpretedVm<1>;
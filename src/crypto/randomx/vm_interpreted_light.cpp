@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "crypto/randomx/vm_interpreted_light.hpp"
 #include "crypto/randomx/dataset.hpp"
 
+#include <cstring>
+
 namespace randomx {
 
 	template<int softAes>
@@ -41,8 +43,13 @@ namespace randomx {
 	void InterpretedLightVm<softAes>::datasetRead(uint64_t address, int_reg_t(&r)[8]) {
 		uint32_t itemNumber = address / CacheLineSize;
 		int_reg_t rl[8];
-		
-		initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+
+		if (itemNumber < partialDatasetItems) {
+			memcpy(rl, partialDataset + itemNumber * CacheLineSize, CacheLineSize);
+		}
+		else {
+			initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+		}
 
 		for (unsigned q = 0; q < 8; ++q)
 			r[q] ^= rl[q];
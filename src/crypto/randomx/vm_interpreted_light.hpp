@@ -38,6 +38,8 @@ namespace randomx {
 	public:
 		using VmBase<softAes>::mem;
 		using VmBase<softAes>::cachePtr;
+		using VmBase<softAes>::partialDataset;
+		using VmBase<softAes>::partialDatasetItems;
 
 		void* operator new(size_t, void* ptr) { return ptr; }
 		void operator delete(void*) {}
@@ -21,7 +21,9 @@
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxQueue.h"
+#include "crypto/rx/RxVm.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
 
@@ -124,6 +126,9 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    randomx_set_threaded_interpreter(config.interpreter() != RxConfig::InterpreterBytecode);
+    RxVm::setJIT(config.interpreter() == RxConfig::InterpreterAuto);
+    RxDataset::setMediumSize(static_cast<size_t>(config.mediumSize()) * 1024U * 1024U);
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
@@ -140,7 +145,7 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         return true;
     }
 
-    d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
+    d_ptr->queue.enqueue(seed, config.nodeset(), config.isNUMAInterleave(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
 
     return false;
 }
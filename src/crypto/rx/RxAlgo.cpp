@@ -22,14 +22,43 @@
 #include "crypto/rx/RxAlgo.h"
 
 
+#include <atomic>
+
+
+namespace xmrig {
+
+
+// Odd while apply() rewrites the global configuration.
+static std::atomic<uint64_t> configGeneration{ 0 };
+static std::atomic<int> configAlgorithm{ Algorithm::INVALID };
+
+
+} // namespace xmrig
+
+
 xmrig::Algorithm::Id xmrig::RxAlgo::apply(Algorithm::Id algorithm)
 {
+    ++configGeneration;
     randomx_apply_config(*base(algorithm));
+    configAlgorithm = algorithm;
+    ++configGeneration;
 
     return algorithm;
 }
 
 
+bool xmrig::RxAlgo::isApplied(Algorithm::Id algorithm, uint64_t generation)
+{
+    return (generation & 1) == 0 && configGeneration == generation && base(static_cast<Algorithm::Id>(configAlgorithm.load())) == base(algorithm);
+}
+
+
+uint64_t xmrig::RxAlgo::generation()
+{
+    return configGeneration;
+}
+
+
 const RandomX_ConfigurationBase *xmrig::RxAlgo::base(Algorithm::Id algorithm)
 {
     switch (algorithm) {
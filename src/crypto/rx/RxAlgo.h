@@ -39,6 +39,8 @@ class RxAlgo
 {
 public:
     static Algorithm::Id apply(Algorithm::Id algorithm);
+    static bool isApplied(Algorithm::Id algorithm, uint64_t generation);
+    static uint64_t generation();
     static const RandomX_ConfigurationBase *base(Algorithm::Id algorithm);
     static uint32_t programCount(Algorithm::Id algorithm);
     static uint32_t programIterations(Algorithm::Id algorithm);
@@ -22,13 +22,19 @@
 #include "backend/common/Tags.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Startup.h"
 #include "base/tools/Chrono.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxSeed.h"
 
 
+#include <thread>
+
+
 namespace xmrig {
 
 
@@ -40,7 +46,7 @@ class RxBasicStoragePrivate
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStoragePrivate)
 
-    inline RxBasicStoragePrivate() = default;
+    inline explicit RxBasicStoragePrivate(const std::vector<uint32_t> &interleave) : m_interleave(interleave) {}
     inline ~RxBasicStoragePrivate() { deleteDataset(); }
 
     inline bool isReady(const Job &job) const   { return m_ready && m_seed == job; }
@@ -60,11 +66,19 @@ public:
     }
 
 
-    inline bool createDataset(bool hugePages, bool oneGbPages, RxConfig::Mode mode)
+    inline bool createDataset(bool hugePages, bool oneGbPages, RxConfig::Mode mode, uint32_t threads)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        if (m_interleave.empty()) {
+            m_dataset = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+            m_dataset->prefault(threads);
+        }
+        else {
+            std::thread thread(allocateInterleaved, this, hugePages, oneGbPages, mode, threads);
+            thread.join();
+        }
+
         if (!m_dataset->cache()->get()) {
             deleteDataset();
 
@@ -75,6 +89,8 @@ public:
 
         printAllocStatus(ts);
 
+        Startup::set(Startup::DATASET_ALLOC, Chrono::steadyMSecs() - ts);
+
         return true;
     }
 
@@ -86,21 +102,77 @@ public:
         m_ready = m_dataset->init(m_seed.data(), threads, priority);
 
         if (m_ready) {
+            Startup::set(Startup::DATASET_INIT, Chrono::steadyMSecs() - ts);
+        }
+
+        if (m_ready && m_dataset->partialItems()) {
+            LOG_INFO("%s" GREEN_BOLD("dataset ready") " medium mode " CYAN_BOLD("%1.0f%%") " precomputed" BLACK_BOLD(" (%" PRIu64 " ms)"),
+                     Tags::randomx(),
+                     m_dataset->partialItems() * 100.0 / randomx_dataset_item_count(),
+                     Chrono::steadyMSecs() - ts
+                     );
+        }
+        else if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
         }
     }
 
 
 private:
+    // The dataset is allocated on a helper thread with an interleave memory policy, huge pages are reserved on
+    // every node of the set and prefaulted by its child threads which inherit the policy, the remaining pages
+    // are touched here, so all of them are spread across the nodes before the init threads start writing.
+    static void allocateInterleaved(RxBasicStoragePrivate *d_ptr, bool hugePages, bool oneGbPages, RxConfig::Mode mode, uint32_t threads)
+    {
+        const bool interleaved = VirtualMemory::interleave(d_ptr->m_interleave);
+        d_ptr->m_dataset       = new RxDataset(hugePages, oneGbPages, true, mode, 0);
+        d_ptr->m_dataset->prefault(threads);
+
+        auto raw = static_cast<uint8_t *>(d_ptr->m_dataset->raw());
+        if (!interleaved || !raw) {
+            LOG_WARN("%s" YELLOW("can't interleave dataset memory across NUMA nodes"), Tags::randomx());
+
+            return;
+        }
+
+        if (!d_ptr->m_dataset->isHugePages()) {
+            for (size_t i = 0; i < RxDataset::maxSize(); i += 4096) {
+                raw[i] = 0;
+            }
+        }
+
+        // The kernel silently falls back to other nodes when one of them runs out of huge pages, so check where the
+        // pages actually are, one sample per huge page is enough.
+        const size_t stride   = d_ptr->m_dataset->isOneGbPages() ? VirtualMemory::kOneGiB : VirtualMemory::hugePageSize();
+        const auto placement  = VirtualMemory::placement(raw, d_ptr->m_dataset->size(false), stride);
+        const size_t expected = (d_ptr->m_dataset->size(false) / stride) / d_ptr->m_interleave.size();
+
+        size_t nodes = 0;
+        for (uint32_t node : d_ptr->m_interleave) {
+            if (placement.count(node) && placement.at(node) >= expected / 2) {
+                ++nodes;
+            }
+        }
+
+        if (!placement.empty() && nodes < d_ptr->m_interleave.size()) {
+            LOG_WARN("%s" YELLOW("dataset pages are not spread evenly, only %zu of %zu NUMA nodes hold their share"), Tags::randomx(), nodes, d_ptr->m_interleave.size());
+
+            return;
+        }
+
+        LOG_INFO("%s" "dataset interleaved across " CYAN_BOLD("%zu") " NUMA nodes", Tags::randomx(), d_ptr->m_interleave.size());
+    }
+
+
     void printAllocStatus(uint64_t ts)
     {
-        if (m_dataset->get() != nullptr) {
+        if (m_dataset->get() != nullptr || m_dataset->partial() != nullptr) {
             const auto pages = m_dataset->hugePages();
 
             LOG_INFO("%s" GREEN_BOLD("allocated") CYAN_BOLD(" %zu MB") BLACK_BOLD(" (%zu+%zu)") " huge pages %s%1.0f%% %u/%u" CLEAR " %sJIT" BLACK_BOLD(" (%" PRIu64 " ms)"),
                      Tags::randomx(),
                      pages.size / oneMiB,
-                     RxDataset::maxSize() / oneMiB,
+                     m_dataset->size(false) / oneMiB,
                      RxCache::maxSize() / oneMiB,
                      (pages.isFullyAllocated() ? GREEN_BOLD_S : (pages.allocated == 0 ? RED_BOLD_S : YELLOW_BOLD_S)),
                      pages.percent(),
@@ -117,6 +189,7 @@ private:
 
 
     bool m_ready         = false;
+    const std::vector<uint32_t> m_interleave;
     RxDataset *m_dataset = nullptr;
     RxSeed m_seed;
 };
@@ -125,8 +198,8 @@ private:
 } // namespace xmrig
 
 
-xmrig::RxBasicStorage::RxBasicStorage() :
-    d_ptr(new RxBasicStoragePrivate())
+xmrig::RxBasicStorage::RxBasicStorage(const std::vector<uint32_t> &interleave) :
+    d_ptr(new RxBasicStoragePrivate(interleave))
 {
 }
 
@@ -167,7 +240,7 @@ void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool huge
 {
     d_ptr->setSeed(seed);
 
-    if (!d_ptr->dataset() && !d_ptr->createDataset(hugePages, oneGbPages, mode)) {
+    if (!d_ptr->dataset() && !d_ptr->createDataset(hugePages, oneGbPages, mode, threads)) {
         return;
     }
 
@@ -24,6 +24,9 @@
 #include "backend/common/interfaces/IRxStorage.h"
 
 
+#include <vector>
+
+
 namespace xmrig
 {
 
@@ -36,7 +39,7 @@ class RxBasicStorage : public IRxStorage
 public:
     XMRIG_DISABLE_COPY_MOVE(RxBasicStorage);
 
-    RxBasicStorage();
+    RxBasicStorage(const std::vector<uint32_t> &interleave = {});
     ~RxBasicStorage() override;
 
 protected:
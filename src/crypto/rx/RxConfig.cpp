@@ -41,20 +41,25 @@ namespace xmrig {
 
 const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
+const char *RxConfig::kInterpreter              = "interpreter";
 const char *RxConfig::kField                    = "randomx";
+const char *RxConfig::kMediumSize               = "medium-size";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
+const char *RxConfig::kVerifyThreads            = "verify-threads";
 
 #ifdef XMRIG_FEATURE_HWLOC
 const char *RxConfig::kNUMA                     = "numa";
+const char *RxConfig::kNUMAInterleave           = "interleave";
 #endif
 
 
-static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light" };
+static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light", "medium" };
+static const std::array<const char *, RxConfig::InterpreterMax> interpreterNames = { "auto", "threaded", "bytecode" };
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -83,20 +88,23 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         m_threads         = Json::getInt(value, kInit, m_threads);
         m_initDatasetAVX2 = Json::getInt(value, kInitAVX2, m_initDatasetAVX2);
         m_mode            = readMode(Json::getValue(value, kMode));
+        m_mediumSize      = Json::getUint(value, kMediumSize, m_mediumSize);
         m_rdmsr           = Json::getBool(value, kRdmsr, m_rdmsr);
+        m_verifyThreads   = std::min(Json::getUint(value, kVerifyThreads, m_verifyThreads), 64U);
 
 #       ifdef XMRIG_FEATURE_MSR
         readMSR(Json::getValue(value, kWrmsr));
 #       endif
 
-        m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_cacheQoS    = Json::getBool(value, kCacheQoS, m_cacheQoS);
+        m_interpreter = readInterpreter(Json::getValue(value, kInterpreter));
 
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
 #       endif
 
 #       ifdef XMRIG_FEATURE_HWLOC
-        if (m_mode == LightMode) {
+        if (m_mode == LightMode || m_mode == MediumMode) {
             m_numa = false;
 
             return true;
@@ -115,6 +123,9 @@ bool xmrig::RxConfig::read(const rapidjson::Value &value)
         else if (numa.IsBool()) {
             m_numa = numa.GetBool();
         }
+        else if (numa.IsString()) {
+            m_interleave = strcasecmp(numa.GetString(), kNUMAInterleave) == 0;
+        }
 #       endif
 
         const auto mode = static_cast<uint32_t>(Json::getInt(value, kScratchpadPrefetchMode, static_cast<int>(m_scratchpadPrefetchMode)));
@@ -138,6 +149,7 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kInit),         m_threads, allocator);
     obj.AddMember(StringRef(kInitAVX2),     m_initDatasetAVX2, allocator);
     obj.AddMember(StringRef(kMode),         StringRef(modeName()), allocator);
+    obj.AddMember(StringRef(kMediumSize),   m_mediumSize, allocator);
     obj.AddMember(StringRef(kOneGbPages),   m_oneGbPages, allocator);
     obj.AddMember(StringRef(kRdmsr),        m_rdmsr, allocator);
 
@@ -160,6 +172,8 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 #   endif
 
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
+    obj.AddMember(StringRef(kInterpreter), StringRef(interpreterName()), allocator);
+    obj.AddMember(StringRef(kVerifyThreads), m_verifyThreads, allocator);
 
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
@@ -171,6 +185,9 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
 
         obj.AddMember(StringRef(kNUMA), numa, allocator);
     }
+    else if (m_interleave) {
+        obj.AddMember(StringRef(kNUMA), StringRef(kNUMAInterleave), allocator);
+    }
     else {
         obj.AddMember(StringRef(kNUMA), m_numa, allocator);
     }
@@ -194,6 +211,12 @@ std::vector<uint32_t> xmrig::RxConfig::nodeset() const
 #endif
 
 
+const char *xmrig::RxConfig::interpreterName() const
+{
+    return interpreterNames[m_interpreter];
+}
+
+
 const char *xmrig::RxConfig::modeName() const
 {
     return modeNames[m_mode];
@@ -279,6 +302,26 @@ void xmrig::RxConfig::readMSR(const rapidjson::Value &value)
 #endif
 
 
+xmrig::RxConfig::Interpreter xmrig::RxConfig::interpreter(const char *name)
+{
+    for (size_t i = 0; i < interpreterNames.size(); i++) {
+        if (strcasecmp(name, interpreterNames[i]) == 0) {
+            return static_cast<Interpreter>(i);
+        }
+    }
+
+    return InterpreterMax;
+}
+
+
+xmrig::RxConfig::Interpreter xmrig::RxConfig::readInterpreter(const rapidjson::Value &value)
+{
+    const Interpreter interpreter = value.IsString() ? RxConfig::interpreter(value.GetString()) : InterpreterMax;
+
+    return interpreter == InterpreterMax ? InterpreterAuto : interpreter;
+}
+
+
 xmrig::RxConfig::Mode xmrig::RxConfig::readMode(const rapidjson::Value &value)
 {
     if (value.IsUint()) {
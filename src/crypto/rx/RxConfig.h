@@ -41,9 +41,17 @@ public:
         AutoMode,
         FastMode,
         LightMode,
+        MediumMode,
         ModeMax
     };
 
+    enum Interpreter : uint32_t {
+        InterpreterAuto,
+        InterpreterThreaded,
+        InterpreterBytecode,
+        InterpreterMax
+    };
+
     enum ScratchpadPrefetchMode : uint32_t {
         ScratchpadPrefetchOff,
         ScratchpadPrefetchT0,
@@ -56,14 +64,18 @@ public:
     static const char *kField;
     static const char *kInit;
     static const char *kInitAVX2;
+    static const char *kInterpreter;
+    static const char *kMediumSize;
     static const char *kMode;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
+    static const char *kVerifyThreads;
     static const char *kWrmsr;
 
 #   ifdef XMRIG_FEATURE_HWLOC
     static const char *kNUMA;
+    static const char *kNUMAInterleave;
 #   endif
 
     bool read(const rapidjson::Value &value);
@@ -71,10 +83,13 @@ public:
 
 #   ifdef XMRIG_FEATURE_HWLOC
     std::vector<uint32_t> nodeset() const;
+    inline bool isNUMAInterleave() const { return m_interleave; }
 #   else
     inline std::vector<uint32_t> nodeset() const { return std::vector<uint32_t>(); }
+    inline bool isNUMAInterleave() const { return false; }
 #   endif
 
+    const char *interpreterName() const;
     const char *modeName() const;
     uint32_t threads(uint32_t limit = 100) const;
 
@@ -84,8 +99,16 @@ public:
     inline bool wrmsr() const           { return m_wrmsr; }
     inline bool cacheQoS() const        { return m_cacheQoS; }
     inline Mode mode() const            { return m_mode; }
+    inline uint32_t mediumSize() const  { return m_mediumSize; }
+    inline uint32_t verifyThreads() const { return m_verifyThreads; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
+    inline void setScratchpadPrefetchMode(ScratchpadPrefetchMode mode) { m_scratchpadPrefetchMode = mode; }
+
+    inline Interpreter interpreter() const                              { return m_interpreter; }
+    inline void setInterpreter(Interpreter interpreter)                 { m_interpreter = interpreter; }
+
+    static Interpreter interpreter(const char *name);
 
 #   ifdef XMRIG_FEATURE_MSR
     const char *msrPresetName() const;
@@ -105,6 +128,7 @@ private:
 
     bool m_cacheQoS = false;
 
+    static Interpreter readInterpreter(const rapidjson::Value &value);
     static Mode readMode(const rapidjson::Value &value);
 
     bool m_oneGbPages     = false;
@@ -112,10 +136,15 @@ private:
     int m_threads         = -1;
     int m_initDatasetAVX2 = -1;
     Mode m_mode           = AutoMode;
+    uint32_t m_mediumSize = 1024;
+    uint32_t m_verifyThreads = 0;
+
+    Interpreter m_interpreter = InterpreterAuto;
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
 
 #   ifdef XMRIG_FEATURE_HWLOC
+    bool m_interleave     = false;
     bool m_numa           = true;
     std::vector<uint32_t> m_nodeset;
 #   endif
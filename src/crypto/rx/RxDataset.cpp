@@ -28,6 +28,7 @@
 #include "crypto/rx/RxCache.h"
 
 
+#include <algorithm>
 #include <thread>
 #include <uv.h>
 
@@ -52,6 +53,9 @@ static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache,
 } // namespace xmrig
 
 
+size_t xmrig::RxDataset::m_mediumSize = 0;
+
+
 xmrig::RxDataset::RxDataset(bool hugePages, bool oneGbPages, bool cache, RxConfig::Mode mode, uint32_t node) :
     m_mode(mode),
     m_node(node)
@@ -80,6 +84,7 @@ xmrig::RxDataset::RxDataset(RxCache *cache) :
 xmrig::RxDataset::~RxDataset()
 {
     randomx_release_dataset(m_dataset);
+    randomx_release_dataset(m_partial);
 
     delete m_cache;
     delete m_memory;
@@ -94,11 +99,18 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
 
     m_cache->init(seed);
 
-    if (!get()) {
+    if (!get() && !m_partial) {
         return true;
     }
 
-    const uint64_t datasetItemCount = randomx_dataset_item_count();
+    randomx_dataset *dataset  = m_dataset;
+    uint64_t datasetItemCount = randomx_dataset_item_count();
+
+    if (m_partial) {
+        dataset          = m_partial;
+        datasetItemCount = std::min<uint64_t>(m_memory->size() / RANDOMX_DATASET_ITEM_SIZE, datasetItemCount);
+        m_partialItems   = static_cast<uint32_t>(datasetItemCount);
+    }
 
     if (numThreads > 1) {
         std::vector<std::thread> threads;
@@ -107,7 +119,7 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         for (uint64_t i = 0; i < numThreads; ++i) {
             const uint32_t a = (datasetItemCount * i) / numThreads;
             const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
-            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority);
+            threads.emplace_back(init_dataset_wrapper, dataset, m_cache->get(), a, b - a, priority);
         }
 
         for (uint32_t i = 0; i < numThreads; ++i) {
@@ -115,7 +127,7 @@ bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priorit
         }
     }
     else {
-        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
+        init_dataset_wrapper(dataset, m_cache->get(), 0, datasetItemCount, priority);
     }
 
     return true;
@@ -153,6 +165,9 @@ size_t xmrig::RxDataset::size(bool cache) const
     if (m_dataset) {
         size += maxSize();
     }
+    else if (m_partial) {
+        size += m_memory->size();
+    }
 
     if (cache && m_cache) {
         size += RxCache::maxSize();
@@ -178,12 +193,26 @@ uint8_t *xmrig::RxDataset::tryAllocateScrathpad()
 }
 
 
+void *xmrig::RxDataset::partial() const
+{
+    return m_partial ? randomx_get_dataset_memory(m_partial) : nullptr;
+}
+
+
 void *xmrig::RxDataset::raw() const
 {
     return m_dataset ? randomx_get_dataset_memory(m_dataset) : nullptr;
 }
 
 
+void xmrig::RxDataset::prefault(uint32_t threads, int64_t node)
+{
+    if (m_memory) {
+        m_memory->prefault(threads, node);
+    }
+}
+
+
 void xmrig::RxDataset::setRaw(const void *raw)
 {
     if (!m_dataset) {
@@ -203,13 +232,17 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
         return;
     }
 
+    if (m_mode == RxConfig::MediumMode) {
+        return allocatePartial(hugePages);
+    }
+
     if (m_mode == RxConfig::AutoMode && uv_get_total_memory() < (maxSize() + RxCache::maxSize())) {
         LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset", Tags::randomx());
 
         return;
     }
 
-    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node);
+    m_memory  = new VirtualMemory(maxSize(), hugePages, oneGbPages, false, m_node, 64, false);
 
     if (m_memory->isOneGbPages()) {
         m_scratchpadOffset = maxSize() + RANDOMX_CACHE_MAX_SIZE;
@@ -224,3 +257,21 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
     }
 #   endif
 }
+
+
+void xmrig::RxDataset::allocatePartial(bool hugePages)
+{
+#   ifdef XMRIG_ARM
+    LOG_ERR(CLEAR "%s" RED_BOLD_S "medium RandomX mode is not supported on this platform", Tags::randomx());
+#   else
+    const size_t size = std::min(m_mediumSize, maxSize()) & ~static_cast<size_t>(RANDOMX_DATASET_ITEM_SIZE - 1);
+    if (size == 0) {
+        LOG_ERR(CLEAR "%s" RED_BOLD_S "medium RandomX mode requires non-zero dataset size", Tags::randomx());
+
+        return;
+    }
+
+    m_memory  = new VirtualMemory(size, hugePages, false, false, m_node, 64, false);
+    m_partial = randomx_create_dataset(m_memory->raw());
+#   endif
+}
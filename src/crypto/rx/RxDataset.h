@@ -52,6 +52,7 @@ public:
 
     inline randomx_dataset *get() const     { return m_dataset; }
     inline RxCache *cache() const           { return m_cache; }
+    inline uint32_t partialItems() const    { return m_partialItems; }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
     bool init(const Buffer &seed, uint32_t numThreads, int priority);
@@ -60,17 +61,25 @@ public:
     HugePagesInfo hugePages(bool cache = true) const;
     size_t size(bool cache = true) const;
     uint8_t *tryAllocateScrathpad();
+    void *partial() const;
     void *raw() const;
+    void prefault(uint32_t threads, int64_t node = -1);
     void setRaw(const void *raw);
 
     static inline constexpr size_t maxSize() { return RANDOMX_DATASET_MAX_SIZE; }
+    static inline void setMediumSize(size_t size) { m_mediumSize = size; }
 
 private:
     void allocate(bool hugePages, bool oneGbPages);
+    void allocatePartial(bool hugePages);
+
+    static size_t m_mediumSize;
 
     const RxConfig::Mode m_mode = RxConfig::FastMode;
     const uint32_t m_node;
     randomx_dataset *m_dataset  = nullptr;
+    randomx_dataset *m_partial  = nullptr;
+    uint32_t m_partialItems     = 0;
     RxCache *m_cache            = nullptr;
     size_t m_scratchpadLimit    = 0;
     std::atomic<size_t> m_scratchpadOffset{};
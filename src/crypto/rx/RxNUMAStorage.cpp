@@ -23,6 +23,7 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
+#include "base/kernel/Startup.h"
 #include "base/tools/Chrono.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
@@ -30,6 +31,7 @@
 #include "crypto/rx/RxSeed.h"
 
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <hwloc.h>
@@ -61,6 +63,15 @@ static bool bindToNUMANode(uint32_t nodeId)
 }
 
 
+static uint32_t nodeThreads(uint32_t nodeId)
+{
+    auto cpu         = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
+
+    return node ? std::max(hwloc_bitmap_weight(node->cpuset), 1) : 1;
+}
+
+
 static inline void printSkipped(uint32_t nodeId, const char *reason)
 {
     LOG_WARN("%s" CYAN_BOLD("#%u ") RED_BOLD("skipped") YELLOW(" (%s)"), Tags::randomx(), nodeId, reason);
@@ -111,12 +122,12 @@ public:
     }
 
 
-    inline bool createDatasets(bool hugePages, bool oneGbPages)
+    inline bool createDatasets(bool hugePages, bool oneGbPages, uint32_t threads)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
         for (uint32_t node : m_nodeset) {
-            m_threads.emplace_back(allocate, this, node, hugePages, oneGbPages);
+            m_threads.emplace_back(allocate, this, node, hugePages, oneGbPages, threads);
         }
 
         join();
@@ -145,6 +156,8 @@ public:
 
         m_allocated = true;
 
+        Startup::set(Startup::DATASET_ALLOC, Chrono::steadyMSecs() - ts);
+
         return true;
     }
 
@@ -194,6 +207,8 @@ public:
         }
 
         m_ready = true;
+
+        Startup::set(Startup::DATASET_INIT, Chrono::steadyMSecs() - ts);
     }
 
 
@@ -209,7 +224,7 @@ public:
 
 
 private:
-    static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages)
+    static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages, uint32_t threads)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
@@ -227,6 +242,8 @@ private:
             return;
         }
 
+        dataset->prefault(std::min(threads, nodeThreads(nodeId)), nodeId);
+
         std::lock_guard<std::mutex> lock(mutex);
         d_ptr->m_datasets.insert({ nodeId, dataset });
         RxNUMAStoragePrivate::printAllocStatus(dataset, nodeId, ts);
@@ -376,7 +393,7 @@ void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugeP
 {
     d_ptr->setSeed(seed);
 
-    if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages)) {
+    if (!d_ptr->isAllocated() && !d_ptr->createDatasets(hugePages, oneGbPages, threads)) {
         return;
     }
 
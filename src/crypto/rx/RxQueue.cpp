@@ -83,19 +83,19 @@ bool xmrig::RxQueue::isReady(const T &seed)
 }
 
 
-void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, bool interleave, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
     if (!m_storage) {
 #       ifdef XMRIG_FEATURE_HWLOC
-        if (!nodeset.empty()) {
+        if (!nodeset.empty() && !interleave) {
             m_storage = new RxNUMAStorage(nodeset);
         }
         else
 #       endif
         {
-            m_storage = new RxBasicStorage();
+            m_storage = new RxBasicStorage(interleave ? nodeset : std::vector<uint32_t>());
         }
     }
 
@@ -103,7 +103,7 @@ void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &no
         return;
     }
 
-    m_queue.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority);
+    m_queue.emplace_back(seed, interleave ? std::vector<uint32_t>() : nodeset, threads, hugePages, oneGbPages, mode, priority);
     m_seed  = seed;
     m_state = STATE_PENDING;
 
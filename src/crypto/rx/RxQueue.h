@@ -77,7 +77,7 @@ public:
     HugePagesInfo hugePages();
     RxDataset *dataset(const Job &job, uint32_t nodeId);
     template<typename T> bool isReady(const T &seed);
-    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, bool interleave, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
 
 protected:
     inline void onAsync() override  { onReady(); }
@@ -0,0 +1,499 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxVerifier.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/api/MetricsWriter.h"
+#include "base/io/Async.h"
+#include "base/io/json/Json.h"
+#include "base/net/http/HttpApiResponse.h"
+#include "base/net/http/HttpData.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
+#include "crypto/rx/Rx.h"
+#include "crypto/rx/RxAlgo.h"
+#include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxVm.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static constexpr size_t kChunk      = 8;
+static constexpr size_t kHashSize   = 32;
+
+
+struct RxVerifier::Batch
+{
+    inline Batch(uint64_t id, const Algorithm &algorithm, size_t depth) :
+        algorithm(algorithm),
+        id(id),
+        depth(depth),
+        submitted(Chrono::steadyMSecs())
+    {}
+
+    const Algorithm algorithm;
+    const uint64_t id;
+    const size_t depth;
+    const uint64_t submitted;
+    Buffer seed;
+    std::shared_ptr<const Job> job;
+    std::vector<Buffer> blobs;
+    std::vector<Buffer> results;
+    std::vector<uint8_t> hashes;
+    std::atomic<bool> stale{ false };
+    size_t done         = 0;
+    size_t light        = 0;
+    size_t next         = 0;
+    uint64_t finished   = 0;
+    uint64_t started    = 0;
+};
+
+
+struct RxVerifier::Worker
+{
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(Worker)
+
+    inline explicit Worker(bool hugePages) : memory(new VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, hugePages, false, false)) {}
+
+    inline ~Worker()
+    {
+        RxVm::destroy(vm);
+        RxVm::destroy(lightVm);
+
+        delete memory;
+    }
+
+    Buffer seed;
+    randomx_vm *lightVm     = nullptr;
+    randomx_vm *vm          = nullptr;
+    RxDataset *dataset      = nullptr;
+    uint64_t cacheVersion   = 0;
+    VirtualMemory *memory;
+};
+
+
+} // namespace xmrig
+
+
+xmrig::RxVerifier::RxVerifier(uint32_t threads, bool hugePages, bool hwAES, const Assembly &assembly) :
+    m_assembly(assembly),
+    m_hugePages(hugePages),
+    m_hwAES(hwAES)
+{
+    m_async = std::make_shared<Async>(this);
+
+    m_threads.reserve(threads);
+    for (uint32_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&RxVerifier::run, this);
+    }
+}
+
+
+xmrig::RxVerifier::~RxVerifier()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+    lock.unlock();
+
+    m_cv.notify_all();
+
+    for (auto &thread : m_threads) {
+        thread.join();
+    }
+
+    onAsync();
+
+    for (const auto &batch : m_queue) {
+        HttpApiResponse(batch->id, 503 /* SERVICE_UNAVAILABLE */).end();
+    }
+
+    delete m_light;
+}
+
+
+rapidjson::Value xmrig::RxVerifier::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("threads",    threads(), allocator);
+    out.AddMember("queue",      static_cast<uint64_t>(m_pending), allocator);
+    out.AddMember("batches",    m_batches, allocator);
+    out.AddMember("hashes",     m_hashes.load(), allocator);
+    out.AddMember("light",      m_lightHashes.load(), allocator);
+    out.AddMember("rejected",   m_rejected, allocator);
+    out.AddMember("latency",    m_latency, allocator);
+
+    Value hashrate(kArrayType);
+    hashrate.PushBack(Hashrate::normalize(m_hashrate.calc(Hashrate::ShortInterval)),  allocator);
+    hashrate.PushBack(Hashrate::normalize(m_hashrate.calc(Hashrate::MediumInterval)), allocator);
+    hashrate.PushBack(Hashrate::normalize(m_hashrate.calc(Hashrate::LargeInterval)),  allocator);
+
+    out.AddMember("hashrate",   hashrate, allocator);
+
+    return out;
+}
+
+
+void xmrig::RxVerifier::getMetrics(MetricsWriter &metrics) const
+{
+    static const char *windows[]    = { "10s", "60s", "15m" };
+    static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+    metrics.add("xmrig_verify_hashrate", MetricsWriter::GAUGE, "Verification hashes per second by averaging window.");
+    for (size_t i = 0; i < 3; ++i) {
+        metrics.sample("xmrig_verify_hashrate", { { "window", windows[i] } }, m_hashrate.calc(intervals[i]));
+    }
+
+    metrics.add("xmrig_verify_hashes_total", MetricsWriter::COUNTER, "Blobs hashed by the verification threads.");
+    metrics.sample("xmrig_verify_hashes_total", { { "mode", "dataset" } }, m_hashes.load() - m_lightHashes.load());
+    metrics.sample("xmrig_verify_hashes_total", { { "mode", "light" } }, m_lightHashes.load());
+
+    metrics.add("xmrig_verify_batches_total", MetricsWriter::COUNTER, "Completed verification batches.");
+    metrics.sample("xmrig_verify_batches_total", m_batches);
+
+    metrics.add("xmrig_verify_rejected_total", MetricsWriter::COUNTER, "Verification batches rejected because the queue was full.");
+    metrics.sample("xmrig_verify_rejected_total", m_rejected);
+
+    metrics.add("xmrig_verify_queue_depth", MetricsWriter::GAUGE, "Blobs submitted for verification and not answered yet.");
+    metrics.sample("xmrig_verify_queue_depth", static_cast<uint64_t>(m_pending));
+
+    metrics.add("xmrig_verify_latency_seconds", MetricsWriter::GAUGE, "Time from submission to answer of the last verification batch.");
+    metrics.sample("xmrig_verify_latency_seconds", m_latency / 1000.0);
+}
+
+
+void xmrig::RxVerifier::submit(const HttpData &req, const std::shared_ptr<const Job> &job)
+{
+    using namespace rapidjson;
+
+    auto fail = [&req](int status, const char *message) {
+        HttpApiResponse response(req.id(), status);
+        response.doc().AddMember("error", StringRef(message), response.doc().GetAllocator());
+        response.end();
+    };
+
+    const Algorithm &algorithm = job->algorithm();
+    if (algorithm.family() != Algorithm::RANDOM_X) {
+        return fail(503 /* SERVICE_UNAVAILABLE */, "no RandomX job");
+    }
+
+    // The light cache uses the global RandomX configuration, which is only valid once a dataset for the algorithm was initialized.
+    if (Rx::isReady(*job)) {
+        m_ready = algorithm;
+    }
+
+    if (m_ready != algorithm) {
+        return fail(503 /* SERVICE_UNAVAILABLE */, "dataset is not ready");
+    }
+
+    Document body;
+    if (body.Parse(req.body.c_str()).HasParseError() || !body.IsObject()) {
+        return fail(400 /* BAD_REQUEST */, "invalid JSON");
+    }
+
+    const char *algo = Json::getString(body, "algo");
+    if (algo && Algorithm(algo) != algorithm) {
+        return fail(400 /* BAD_REQUEST */, "algo does not match the current job");
+    }
+
+    const auto &blobs   = Json::getArray(body, "blobs");
+    const auto &results = Json::getArray(body, "results");
+
+    if (!blobs.IsArray() || blobs.Empty() || blobs.Size() > kMaxBatch) {
+        return fail(400 /* BAD_REQUEST */, "blobs must be an array of 1-4096 hex strings");
+    }
+
+    if (!results.IsNull() && (!results.IsArray() || results.Size() != blobs.Size())) {
+        return fail(400 /* BAD_REQUEST */, "results must have the same size as blobs");
+    }
+
+    if (m_pending + blobs.Size() > kMaxPending) {
+        ++m_rejected;
+
+        return fail(503 /* SERVICE_UNAVAILABLE */, "queue is full");
+    }
+
+    auto batch       = std::make_shared<Batch>(req.id(), algorithm, m_pending);
+    const auto &seed = Json::getValue(body, "seed_hash");
+
+    if (seed.IsNull()) {
+        batch->seed = job->seed();
+    }
+    else if (!Cvt::fromHex(batch->seed, seed) || batch->seed.size() != kHashSize) {
+        return fail(400 /* BAD_REQUEST */, "invalid seed_hash");
+    }
+
+    batch->blobs.resize(blobs.Size());
+    for (SizeType i = 0; i < blobs.Size(); ++i) {
+        if (!Cvt::fromHex(batch->blobs[i], blobs[i]) || batch->blobs[i].empty() || batch->blobs[i].size() > Job::kMaxBlobSize) {
+            return fail(400 /* BAD_REQUEST */, "invalid blob");
+        }
+    }
+
+    if (results.IsArray()) {
+        batch->results.resize(results.Size());
+        for (SizeType i = 0; i < results.Size(); ++i) {
+            if (!Cvt::fromHex(batch->results[i], results[i]) || batch->results[i].size() != kHashSize) {
+                return fail(400 /* BAD_REQUEST */, "invalid result");
+            }
+        }
+    }
+
+    batch->hashes.resize(batch->blobs.size() * kHashSize);
+
+    if (job->seed() == batch->seed) {
+        batch->job = job;
+    }
+
+    m_pending += batch->blobs.size();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queue.emplace_back(std::move(batch));
+    lock.unlock();
+
+    m_cv.notify_all();
+}
+
+
+void xmrig::RxVerifier::tick(uint64_t ts)
+{
+    m_hashrate.add(m_hashes.load(), ts);
+}
+
+
+void xmrig::RxVerifier::onAsync()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::deque<std::shared_ptr<Batch> > finished;
+    finished.swap(m_finished);
+    lock.unlock();
+
+    for (const auto &batch : finished) {
+        m_pending -= batch->blobs.size();
+        m_latency  = batch->finished - batch->submitted;
+        ++m_batches;
+
+        reply(*batch);
+    }
+}
+
+
+size_t xmrig::RxVerifier::hash(Worker &worker, Batch &batch, size_t begin, size_t end)
+{
+    // Hashes depend on the global RandomX configuration, they are dropped if it was switched to another algorithm
+    // before or while they were computed.
+    const uint64_t generation = RxAlgo::generation();
+    if (!RxAlgo::isApplied(batch.algorithm.id(), generation)) {
+        batch.stale = true;
+
+        return 0;
+    }
+
+    if (batch.job) {
+        RxDataset *dataset = Rx::dataset(*batch.job, 0);
+
+        if (dataset) {
+            if (!worker.vm || worker.dataset != dataset || worker.seed != batch.seed) {
+                RxVm::destroy(worker.vm);
+
+                worker.vm       = RxVm::create(dataset, worker.memory->scratchpad(), !m_hwAES, m_assembly, 0);
+                worker.dataset  = dataset;
+                worker.seed     = batch.seed;
+            }
+
+            for (size_t i = begin; i < end; ++i) {
+                randomx_calculate_hash(worker.vm, batch.blobs[i].data(), batch.blobs[i].size(), batch.hashes.data() + i * kHashSize);
+            }
+
+            // The dataset is rewritten in place on a seed change, hashes only count if it still holds the same seed.
+            if (Rx::isReady(*batch.job) && RxAlgo::isApplied(batch.algorithm.id(), generation)) {
+                m_hashes += end - begin;
+
+                return 0;
+            }
+        }
+    }
+
+    const uint64_t version = acquireCache(batch.algorithm, batch.seed);
+
+    if (!worker.lightVm || worker.cacheVersion != version) {
+        RxVm::destroy(worker.lightVm);
+
+        worker.lightVm      = RxVm::create(m_light, worker.memory->scratchpad(), !m_hwAES, m_assembly, 0);
+        worker.cacheVersion = version;
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+        randomx_calculate_hash(worker.lightVm, batch.blobs[i].data(), batch.blobs[i].size(), batch.hashes.data() + i * kHashSize);
+    }
+
+    releaseCache();
+
+    if (!RxAlgo::isApplied(batch.algorithm.id(), generation)) {
+        batch.stale = true;
+
+        return 0;
+    }
+
+    m_hashes      += end - begin;
+    m_lightHashes += end - begin;
+
+    return end - begin;
+}
+
+
+uint64_t xmrig::RxVerifier::acquireCache(const Algorithm &algorithm, const Buffer &seed)
+{
+    std::unique_lock<std::mutex> lock(m_cacheMutex);
+    m_cacheCv.wait(lock, [this, &algorithm, &seed] { return m_cacheReaders == 0 || (m_lightAlgorithm == algorithm && m_light->cache()->seed() == seed); });
+
+    // The cache is keyed by algorithm and seed, the Argon2 parameters differ between algorithms with the same seed.
+    if (m_light && m_lightAlgorithm != algorithm) {
+        delete m_light;
+        m_light = nullptr;
+    }
+
+    if (!m_light) {
+        m_light          = new RxDataset(new RxCache(m_hugePages, 0));
+        m_lightAlgorithm = algorithm;
+    }
+
+    if (m_light->cache()->init(seed)) {
+        ++m_cacheVersion;
+    }
+
+    ++m_cacheReaders;
+
+    return m_cacheVersion;
+}
+
+
+void xmrig::RxVerifier::releaseCache()
+{
+    std::unique_lock<std::mutex> lock(m_cacheMutex);
+    --m_cacheReaders;
+    lock.unlock();
+
+    m_cacheCv.notify_all();
+}
+
+
+void xmrig::RxVerifier::reply(const Batch &batch) const
+{
+    using namespace rapidjson;
+
+    if (batch.stale) {
+        HttpApiResponse response(batch.id, 503 /* SERVICE_UNAVAILABLE */);
+        response.doc().AddMember("error", "algorithm changed while hashing", response.doc().GetAllocator());
+
+        return response.end();
+    }
+
+    HttpApiResponse response(batch.id);
+    auto &doc       = response.doc();
+    auto &allocator = doc.GetAllocator();
+
+    const size_t count  = batch.blobs.size();
+    const uint64_t time = batch.finished - batch.started;
+
+    Value hashes(kArrayType);
+    hashes.Reserve(static_cast<SizeType>(count), allocator);
+
+    for (size_t i = 0; i < count; ++i) {
+        hashes.PushBack(Cvt::toHex(batch.hashes.data() + i * kHashSize, kHashSize, doc), allocator);
+    }
+
+    doc.AddMember("algo",       batch.algorithm.toJSON(), allocator);
+    doc.AddMember("seed_hash",  Cvt::toHex(batch.seed, doc), allocator);
+    doc.AddMember("count",      static_cast<uint64_t>(count), allocator);
+    doc.AddMember("hashes",     hashes, allocator);
+
+    if (!batch.results.empty()) {
+        Value valid(kArrayType);
+        valid.Reserve(static_cast<SizeType>(count), allocator);
+
+        for (size_t i = 0; i < count; ++i) {
+            valid.PushBack(memcmp(batch.results[i].data(), batch.hashes.data() + i * kHashSize, kHashSize) == 0, allocator);
+        }
+
+        doc.AddMember("valid", valid, allocator);
+    }
+
+    doc.AddMember("light",      static_cast<uint64_t>(batch.light), allocator);
+    doc.AddMember("depth",      static_cast<uint64_t>(batch.depth), allocator);
+    doc.AddMember("queue_ms",   batch.started - batch.submitted, allocator);
+    doc.AddMember("elapsed_ms", time, allocator);
+    doc.AddMember("hashrate",   time ? count * 1000.0 / time : 0.0, allocator);
+
+    response.end();
+}
+
+
+void xmrig::RxVerifier::run()
+{
+    Worker worker(m_hugePages);
+
+    while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
+
+        if (m_shutdown) {
+            break;
+        }
+
+        std::shared_ptr<Batch> batch = m_queue.front();
+        const size_t begin           = batch->next;
+        const size_t end             = std::min(begin + kChunk, batch->blobs.size());
+
+        batch->next = end;
+        if (!batch->started) {
+            batch->started = Chrono::steadyMSecs();
+        }
+
+        if (end == batch->blobs.size()) {
+            m_queue.pop_front();
+        }
+
+        lock.unlock();
+
+        const size_t light = hash(worker, *batch, begin, end);
+
+        lock.lock();
+        batch->light += light;
+        batch->done  += end - begin;
+
+        if (batch->done == batch->blobs.size()) {
+            batch->finished = Chrono::steadyMSecs();
+            m_finished.emplace_back(std::move(batch));
+            lock.unlock();
+
+            m_async->send();
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_VERIFIER_H
+#define XMRIG_RX_VERIFIER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/common/Hashrate.h"
+#include "base/crypto/Algorithm.h"
+#include "base/kernel/interfaces/IAsyncListener.h"
+#include "base/tools/Buffer.h"
+#include "base/tools/Object.h"
+#include "crypto/common/Assembly.h"
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+class Async;
+class HttpData;
+class Job;
+class MetricsWriter;
+class RxDataset;
+
+
+// Hashes batches of blobs submitted over the HTTP API on its own threads and VMs, never touching the mining
+// workers. Blobs for the seed of the current job are hashed on the resident dataset, any other seed of the same
+// algorithm falls back to a light VM on a private cache that holds the most recently requested seed.
+class RxVerifier : public IAsyncListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxVerifier)
+
+    static constexpr size_t kMaxBatch   = 4096;
+    static constexpr size_t kMaxPending = 65536;
+
+    RxVerifier(uint32_t threads, bool hugePages, bool hwAES, const Assembly &assembly);
+    ~RxVerifier() override;
+
+    inline uint32_t threads() const { return static_cast<uint32_t>(m_threads.size()); }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void getMetrics(MetricsWriter &metrics) const;
+    void submit(const HttpData &req, const std::shared_ptr<const Job> &job);
+    void tick(uint64_t ts);
+
+protected:
+    void onAsync() override;
+
+private:
+    struct Batch;
+    struct Worker;
+
+    size_t hash(Worker &worker, Batch &batch, size_t begin, size_t end);
+    uint64_t acquireCache(const Algorithm &algorithm, const Buffer &seed);
+    void releaseCache();
+    void reply(const Batch &batch) const;
+    void run();
+
+    const Assembly m_assembly;
+    const bool m_hugePages;
+    const bool m_hwAES;
+    Algorithm m_lightAlgorithm;
+    Algorithm m_ready;
+    Hashrate m_hashrate{ 0 };
+    RxDataset *m_light      = nullptr;
+    size_t m_pending        = 0;
+    std::atomic<uint64_t> m_hashes{ 0 };
+    std::atomic<uint64_t> m_lightHashes{ 0 };
+    std::condition_variable m_cacheCv;
+    std::condition_variable m_cv;
+    std::deque<std::shared_ptr<Batch> > m_finished;
+    std::deque<std::shared_ptr<Batch> > m_queue;
+    std::mutex m_cacheMutex;
+    std::mutex m_mutex;
+    std::shared_ptr<Async> m_async;
+    std::vector<std::thread> m_threads;
+    uint32_t m_cacheReaders = 0;
+    uint64_t m_batches      = 0;
+    uint64_t m_cacheVersion = 0;
+    uint64_t m_latency      = 0;
+    uint64_t m_rejected     = 0;
+    bool m_shutdown         = false;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_VERIFIER_H */
@@ -25,11 +25,23 @@
 #include "crypto/rx/RxVm.h"
 
 
+#include <atomic>
+
+
 #if defined(XMRIG_FEATURE_SSE4_1)
 extern "C" uint32_t rx_blake2b_use_sse41;
 #endif
 
 
+namespace xmrig {
+
+
+static std::atomic<bool> jit{ true };
+
+
+} // namespace xmrig
+
+
 randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
 {
     int flags = 0;
@@ -42,7 +54,7 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
         flags |= RANDOMX_FLAG_FULL_MEM;
     }
 
-    if (!dataset->cache() || dataset->cache()->isJIT()) {
+    if (jit.load(std::memory_order_relaxed) && (!dataset->cache() || dataset->cache()->isJIT())) {
         flags |= RANDOMX_FLAG_JIT;
     }
 
@@ -55,7 +67,13 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
     rx_blake2b_use_sse41 = Cpu::info()->has(ICpuInfo::FLAG_SSE41) ? 1 : 0;
 #   endif
 
-    return randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node);
+    randomx_vm *vm = randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node);
+
+    if (vm && !dataset->get() && dataset->partialItems()) {
+        randomx_vm_set_partial_dataset(vm, dataset->partial(), dataset->partialItems());
+    }
+
+    return vm;
 }
 
 
@@ -65,3 +83,9 @@ void xmrig::RxVm::destroy(randomx_vm* vm)
         randomx_destroy_vm(vm);
     }
 }
+
+
+void xmrig::RxVm::setJIT(bool enable)
+{
+    jit.store(enable, std::memory_order_relaxed);
+}
@@ -40,6 +40,7 @@ class RxVm
 public:
     static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
     static void destroy(randomx_vm *vm);
+    static void setJIT(bool enable);
 };
 
 
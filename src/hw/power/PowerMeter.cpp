@@ -0,0 +1,179 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/power/PowerMeter.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+
+
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+
+
+namespace xmrig {
+
+
+const char *PowerMeter::kDefaultRoot = "/sys/class/powercap";
+
+
+static const char *kPrefix = "intel-rapl:";
+
+
+static bool readValue(const std::string &path, uint64_t &value)
+{
+    std::ifstream file(path);
+
+    return file.is_open() && (file >> value);
+}
+
+
+static std::string readName(const std::string &path)
+{
+    std::ifstream file(path + "/name");
+    std::string name;
+
+    if (file.is_open()) {
+        std::getline(file, name);
+    }
+
+    return name;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::PowerMeter::PowerMeter(const String &root) :
+    m_root(root)
+{
+    DIR *dir = opendir(m_root);
+    if (!dir) {
+        LOG_WARN("%s " YELLOW("power meter: ") YELLOW_BOLD("%s") YELLOW(" not found"), Tags::miner(), m_root.data());
+
+        return;
+    }
+
+    // Top-level zones (intel-rapl:N) are packages, subzones (intel-rapl:N:M) named "core" hold the core counters.
+    while (const dirent *entry = readdir(dir)) {
+        if (strncmp(entry->d_name, kPrefix, strlen(kPrefix)) != 0) {
+            continue;
+        }
+
+        const std::string path = std::string(m_root.data()) + "/" + entry->d_name;
+        const std::string name = readName(path);
+        const bool subzone     = strchr(entry->d_name + strlen(kPrefix), ':') != nullptr;
+
+        if (!subzone && name.compare(0, 7, "package") == 0) {
+            addZone(PackageDomain, path);
+        }
+        else if (subzone && name == "core") {
+            addZone(CoreDomain, path);
+        }
+    }
+
+    closedir(dir);
+
+    if (!isEnabled()) {
+        LOG_WARN("%s " YELLOW("power meter: no readable RAPL package counters in ") YELLOW_BOLD("%s"), Tags::miner(), m_root.data());
+
+        return;
+    }
+
+    LOG_INFO("%s " WHITE_BOLD("power meter") " RAPL " CYAN_BOLD("%zu") " package(s) " CYAN_BOLD("%zu") " core domain(s)",
+             Tags::miner(), m_meters[PackageDomain].zones.size(), m_meters[CoreDomain].zones.size());
+}
+
+
+double xmrig::PowerMeter::joulesPerHash(double watts, double hashrate)
+{
+    return (watts > 0.0 && hashrate > 0.0) ? watts / hashrate : 0.0;
+}
+
+
+void xmrig::PowerMeter::tick(uint64_t ts)
+{
+    for (auto &meter : m_meters) {
+        if (meter.zones.empty()) {
+            continue;
+        }
+
+        for (auto &zone : meter.zones) {
+            uint64_t value = 0;
+            if (!readValue(zone.path, value)) {
+                continue;
+            }
+
+            // energy_uj wraps at max_energy_range_uj.
+            meter.total += value >= zone.last ? value - zone.last : zone.range - zone.last + value;
+            zone.last    = value;
+        }
+
+        meter.energy.add(meter.total, ts);
+    }
+}
+
+
+#ifdef XMRIG_FEATURE_API
+rapidjson::Value xmrig::PowerMeter::toJSON(const double (&hashrate)[3], rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    static const size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+    Value package(kArrayType);
+    Value core(kArrayType);
+    Value jh(kArrayType);
+    Value hw(kArrayType);
+
+    for (size_t i = 0; i < 3; ++i) {
+        const double w = watts(PackageDomain, intervals[i]);
+
+        package.PushBack(Hashrate::normalize(w), allocator);
+        core.PushBack(isDomain(CoreDomain) ? Hashrate::normalize(watts(CoreDomain, intervals[i])) : Value(kNullType), allocator);
+
+        const double j = joulesPerHash(w, hashrate[i]);
+        jh.PushBack(j > 0.0 ? Value(j) : Value(kNullType), allocator);
+        hw.PushBack(Hashrate::normalize(j > 0.0 ? 1.0 / j : 0.0), allocator);
+    }
+
+    Value out(kObjectType);
+    out.AddMember("package",         package, allocator);
+    out.AddMember("core",            core, allocator);
+    out.AddMember("joules_per_hash", jh, allocator);
+    out.AddMember("hashes_per_watt", hw, allocator);
+
+    return out;
+}
+#endif
+
+
+bool xmrig::PowerMeter::addZone(Domain domain, const std::string &path)
+{
+    Zone zone{ path + "/energy_uj", 0, 0 };
+
+    if (!readValue(zone.path, zone.last) || !readValue(path + "/max_energy_range_uj", zone.range)) {
+        return false;
+    }
+
+    m_meters[domain].zones.emplace_back(std::move(zone));
+
+    return true;
+}
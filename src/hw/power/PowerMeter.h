@@ -0,0 +1,89 @@
+/* XMRig
+ * Copyright (c) 2018-2022 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2022 XMRig       <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_POWERMETER_H
+#define XMRIG_POWERMETER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/common/Hashrate.h"
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class PowerMeter
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(PowerMeter)
+
+    enum Domain : uint32_t {
+        PackageDomain,
+        CoreDomain,
+        DomainMax
+    };
+
+    static const char *kDefaultRoot;
+
+    PowerMeter(const String &root);
+
+    inline bool isDomain(Domain domain) const           { return !m_meters[domain].zones.empty(); }
+    inline bool isEnabled() const                       { return isDomain(PackageDomain); }
+    inline const String &root() const                   { return m_root; }
+    inline double watts(Domain domain, size_t ms) const { return m_meters[domain].energy.calc(ms) / 1e6; }
+
+    static double joulesPerHash(double watts, double hashrate);
+
+    void tick(uint64_t ts);
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(const double (&hashrate)[3], rapidjson::Document &doc) const;
+#   endif
+
+private:
+    struct Zone
+    {
+        std::string path;
+        uint64_t last;
+        uint64_t range;
+    };
+
+    struct Meter
+    {
+        Hashrate energy{ 0 };
+        std::vector<Zone> zones;
+        uint64_t total = 0;
+    };
+
+    bool addZone(Domain domain, const std::string &path);
+
+    const String m_root;
+    Meter m_meters[DomainMax];
+};
+
+
+} // namespace xmrig
+
+
+#endif // XMRIG_POWERMETER_H
@@ -0,0 +1,13 @@
+if (WITH_POWER AND XMRIG_OS_LINUX)
+    add_definitions(/DXMRIG_FEATURE_POWER)
+
+    list(APPEND HEADERS
+        src/hw/power/PowerMeter.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/power/PowerMeter.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_POWER)
+endif()
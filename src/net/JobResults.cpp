@@ -146,6 +146,14 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
     }
     else if (algorithm.family() == Algorithm::KAWPOW) {
 #       ifdef XMRIG_ALGO_KAWPOW
+        const auto cache = KPCache::get(bundle.job.height() / KPHash::EPOCH_LENGTH);
+        if (!cache) {
+            errors += bundle.nonces.size();
+            delete memory;
+
+            return;
+        }
+
         for (uint32_t nonce : bundle.nonces) {
             *bundle.job.nonce() = nonce;
 
@@ -156,12 +164,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             uint32_t output[8];
             uint32_t mix_hash[8];
-            {
-                std::lock_guard<std::mutex> lock(KPCache::s_cacheMutex);
-
-                KPCache::s_cache.init(bundle.job.height() / KPHash::EPOCH_LENGTH);
-                KPHash::calculate(KPCache::s_cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
-            }
+            KPHash::calculate(*cache, bundle.job.height(), header_hash, full_nonce, output, mix_hash);
 
             for (size_t i = 0; i < sizeof(hash); ++i) {
                 hash[i] = ((uint8_t*)output)[sizeof(hash) - 1 - i];
@@ -188,6 +191,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             checkHash(bundle, results, nonce, hash, errors);
         }
+
+        CnCtx::release(ctx, 1);
     }
 
     delete memory;
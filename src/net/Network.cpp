@@ -144,6 +144,11 @@ void xmrig::Network::onActive(IStrategy *strategy, IClient *client)
     if (fingerprint != nullptr) {
         LOG_INFO("%s " BLACK_BOLD("fingerprint (SHA-256): \"%s\""), Tags::network(), fingerprint);
     }
+
+    if (tlsVersion != nullptr && client->tlsHandshakeTime() > 0) {
+        LOG_INFO("%s " BLACK_BOLD("TLS handshake %" PRIu64 " ms (%s), session resumption %.0f%%"),
+                 Tags::network(), client->tlsHandshakeTime(), client->isTLSResumed() ? "resumed" : "full", client->tlsResumption() * 100.0);
+    }
 }
 
 
@@ -233,6 +238,10 @@ void xmrig::Network::onPause(IStrategy *strategy)
 
 void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult &result, const char *error)
 {
+#   ifdef XMRIG_FEATURE_API
+    publishResult(result, error);
+#   endif
+
     uint64_t diff     = result.diff;
     const char *scale = NetworkState::scaleDiff(diff);
 
@@ -258,6 +267,12 @@ void xmrig::Network::onVerifyAlgorithm(IStrategy *, const IClient *, const Algor
 
 
 #ifdef XMRIG_FEATURE_API
+void xmrig::Network::onMetrics(MetricsWriter &metrics)
+{
+    m_state->getMetrics(metrics);
+}
+
+
 void xmrig::Network::onRequest(IApiRequest &request)
 {
     if (request.type() == IApiRequest::REQ_SUMMARY) {
@@ -299,6 +314,10 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
                  Tags::network(), client->pool().host().data(), client->pool().port(), zmq_buf, diff, scale, job.algorithm().name(), height_buf, tx_buf);
     }
 
+#   ifdef XMRIG_FEATURE_API
+    publishJob(client, job, donate);
+#   endif
+
     if (!donate && m_donate) {
         m_donate->setAlgo(job.algorithm());
         m_donate->setProxy(client->pool().proxy());
@@ -326,8 +345,11 @@ void xmrig::Network::getConnection(rapidjson::Value &reply, rapidjson::Document
     using namespace rapidjson;
     auto &allocator = doc.GetAllocator();
 
+    Value connection = m_state->getConnection(doc, version);
+    m_strategy->toJSON(connection, doc);
+
     reply.AddMember("algo",         m_state->algorithm().toJSON(), allocator);
-    reply.AddMember("connection",   m_state->getConnection(doc, version), allocator);
+    reply.AddMember("connection",   connection, allocator);
 }
 
 
@@ -339,3 +361,49 @@ void xmrig::Network::getResults(rapidjson::Value &reply, rapidjson::Document &do
     reply.AddMember("results", m_state->getResults(doc, version), allocator);
 }
 #endif
+
+
+#ifdef XMRIG_FEATURE_API
+void xmrig::Network::publishJob(IClient *client, const Job &job, bool donate) const
+{
+    using namespace rapidjson;
+
+    Api *api = m_controller->api();
+    if (!api->isStreaming()) {
+        return;
+    }
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("pool",   client->pool().url().toJSON(), allocator);
+    doc.AddMember("algo",   job.algorithm().toJSON(), allocator);
+    doc.AddMember("height", job.height(), allocator);
+    doc.AddMember("diff",   job.diff(), allocator);
+    doc.AddMember("donate", donate, allocator);
+
+    api->publish("job", doc);
+}
+
+
+void xmrig::Network::publishResult(const SubmitResult &result, const char *error) const
+{
+    using namespace rapidjson;
+
+    Api *api = m_controller->api();
+    if (!api->isStreaming()) {
+        return;
+    }
+
+    Document doc(kObjectType);
+    auto &allocator = doc.GetAllocator();
+
+    doc.AddMember("accepted",   m_state->accepted(), allocator);
+    doc.AddMember("rejected",   m_state->rejected(), allocator);
+    doc.AddMember("diff",       result.diff, allocator);
+    doc.AddMember("ping",       result.elapsed, allocator);
+    doc.AddMember("error",      error ? Value(error, allocator) : Value(kNullType), allocator);
+
+    api->publish("result", doc);
+}
+#endif
@@ -67,6 +67,7 @@ protected:
     void onVerifyAlgorithm(IStrategy *strategy, const  IClient *client, const Algorithm &algorithm, bool *ok) override;
 
 #   ifdef XMRIG_FEATURE_API
+    void onMetrics(MetricsWriter &metrics) override;
     void onRequest(IApiRequest &request) override;
 #   endif
 
@@ -79,6 +80,8 @@ private:
 #   ifdef XMRIG_FEATURE_API
     void getConnection(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
     void getResults(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
+    void publishJob(IClient *client, const Job &job, bool donate) const;
+    void publishResult(const SubmitResult &result, const char *error) const;
 #   endif
 
     Controller *m_controller;